@@ -0,0 +1,46 @@
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include "bench.hpp"
+
+
+/* The replaced allocation functions live in their own file: when GCC inlines them next to their callers,
+   it pairs the free below with the new expression and reports -Wmismatched-new-delete. */
+
+namespace
+{
+
+/// Counts heap allocations of the whole benchmark executable
+std::atomic<uint64_t> s_allocation_count{0};
+
+}
+
+void* operator new(size_t size)
+{
+    s_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* const pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+namespace bench
+{
+
+uint64_t getAllocationCount()
+{
+    return s_allocation_count.load();
+}
+
+}
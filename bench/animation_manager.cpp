@@ -0,0 +1,56 @@
+#include <vector>
+#include <memory>
+#include "bench.hpp"
+#include "interpolated/animation_manager.hpp"
+
+
+namespace bench
+{
+
+void runAnimationManager()
+{
+    using Value = Interpolated<float, FrameClock>;
+    constexpr size_t value_count = 1'000'000;
+    constexpr size_t moving_count = 10'000;
+    std::cout << "--- AnimationManager, " << moving_count << " moving out of " << value_count << " values ---" << std::endl;
+
+    std::vector<float> destinations(value_count);
+    AnimationManager<Value> manager;
+    std::vector<std::unique_ptr<AnimatedValue<Value>>> values(value_count);
+    FrameClock::sample();
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i] = std::make_unique<AnimatedValue<Value>>(manager, &destinations[i]);
+        values[i]->setDuration(1000.0f);
+        // Evenly spread moving values
+        if (i % (value_count / moving_count) == 0) {
+            *values[i] = 1.0f;
+        }
+    }
+
+    // Polling every value, as required without the manager
+    report("poll all values", measure([&] {
+        FrameClock::sample();
+        for (size_t i{0}; i < value_count; ++i) {
+            destinations[i] = *values[i];
+        }
+        doNotOptimize(destinations.data());
+    }, 1));
+
+    report("manager update", measure([&] {
+        FrameClock::sample();
+        manager.update();
+        doNotOptimize(destinations.data());
+    }, 1));
+
+    // Values without destination leave the active set once their transition is over too
+    AnimationManager<Value> unbound_manager;
+    AnimatedValue<Value> unbound{unbound_manager};
+    unbound.setDuration(1e-9f);
+    unbound = 1.0f;
+    std::cout << "    unbound value active before update: " << unbound_manager.getActiveCount();
+    FrameClock::sample();
+    unbound_manager.update();
+    std::cout << ", after: " << unbound_manager.getActiveCount() << std::endl;
+}
+
+}
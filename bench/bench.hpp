@@ -0,0 +1,118 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+
+namespace bench
+{
+
+/// Minimal 2D vector, benchmarks do not depend on SFML
+struct Vec2
+{
+    float x{};
+    float y{};
+};
+
+inline Vec2 operator+(Vec2 a, Vec2 b) { return {a.x + b.x, a.y + b.y}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return {a.x - b.x, a.y - b.y}; }
+inline Vec2 operator*(Vec2 v, float f) { return {v.x * f, v.y * f}; }
+
+/// Minimal 4D vector, the size of a color or a rectangle
+struct Vec4
+{
+    float x{};
+    float y{};
+    float z{};
+    float w{};
+};
+
+inline Vec4 operator+(Vec4 a, Vec4 b) { return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w}; }
+inline Vec4 operator-(Vec4 a, Vec4 b) { return {a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w}; }
+inline Vec4 operator*(Vec4 v, float f) { return {v.x * f, v.y * f, v.z * f, v.w * f}; }
+
+/// Prevents the compiler from optimizing away the computation of @p value
+template<typename T>
+inline void doNotOptimize(T const& value)
+{
+#if defined(_MSC_VER)
+    static_cast<void>(*static_cast<volatile char const*>(static_cast<void const*>(&value)));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/** Runs @p callback repeatedly for at least @p min_duration_s seconds and returns the
+ *  best observed time per operation in nanoseconds, one call performing @p ops_per_call operations.
+ */
+template<typename TCallback>
+double measure(TCallback&& callback, uint64_t ops_per_call, double min_duration_s = 0.25)
+{
+    using Clock = std::chrono::steady_clock;
+    // Warm up caches and branch predictors
+    callback();
+    double best = 1e300;
+    double total = 0.0;
+    while (total < min_duration_s) {
+        auto const start = Clock::now();
+        callback();
+        double const elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        total += elapsed;
+        best = std::min(best, elapsed);
+    }
+    return best * 1e9 / static_cast<double>(ops_per_call);
+}
+
+/// A single measurement, named after its group
+struct Result
+{
+    std::string name;
+    double      ns_per_op{};
+};
+
+/// Sets the group prefixing the names of the following results
+void setGroup(std::string const& group);
+
+/// Prints a single measurement and records it for the JSON output
+void report(std::string const& name, double ns_per_op);
+
+/// Returns all the recorded measurements
+std::vector<Result> const& getResults();
+
+/// Writes @p results to @p path as JSON, returns false on failure
+bool writeJson(std::string const& path, std::vector<Result> const& results);
+
+/// Reads results previously written by writeJson, returns false on failure
+bool readJson(std::string const& path, std::vector<Result>& results);
+
+/** Compares @p results with @p baseline and prints the differences.
+ *  Returns the number of results slower than their baseline by more than @p threshold (0.1 is 10%).
+ */
+uint32_t compare(std::vector<Result> const& results, std::vector<Result> const& baseline, double threshold);
+
+/// Returns the number of heap allocations made by the benchmark executable so far
+uint64_t getAllocationCount();
+
+// Benchmark groups, defined in their own translation unit
+void runInterpolated();
+void runPez();
+void runInterpolatedArray();
+void runEasing();
+void runTransitionTable();
+void runStaticTransition();
+void runSettled();
+void runAnimationManager();
+void runCompact();
+void runConcurrent();
+void runColor();
+void runVersioning();
+void runVertices();
+void runHeavy();
+void runBuffer();
+void runThreadPool();
+
+}
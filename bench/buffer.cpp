@@ -0,0 +1,60 @@
+#include <vector>
+#include <thread>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+#include "interpolated/interpolated_buffer.hpp"
+#include "peztool/utils/thread_pool.hpp"
+
+
+namespace bench
+{
+
+void runBuffer()
+{
+    constexpr size_t value_count = 1 << 20;
+    std::cout << "--- Buffer morphing (" << value_count << " floats, mid transition) ---" << std::endl;
+    SimulatedClock::enable();
+    std::vector<float> output(value_count);
+
+    std::vector<float> targets(value_count);
+    for (size_t i{0}; i < value_count; ++i) {
+        targets[i] = static_cast<float>(i);
+    }
+
+    // One object per value, each computes its own easing
+    std::vector<Interpolated<float, SteadyClock>> values(value_count);
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i].setDuration(1.0f);
+        values[i].transition = TransitionFunction::EaseInOutExponential;
+        values[i] = targets[i];
+    }
+    // A single transition for the whole buffer
+    InterpolatedBuffer<SteadyClock> buffer{value_count};
+    buffer.setDuration(1.0f);
+    buffer.transition = TransitionFunction::EaseInOutExponential;
+    buffer.setValues(targets);
+    SimulatedClock::advance(toTicks(0.5f));
+
+    report("Interpolated<float> per value", measure([&] {
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count, 0.5));
+
+    report("InterpolatedBuffer", measure([&] {
+        buffer.evaluate(output.data());
+        doNotOptimize(output.data());
+    }, value_count, 0.5));
+
+    uint32_t const thread_count = std::max(1u, std::thread::hardware_concurrency());
+    pez::ThreadPool pool{thread_count};
+    report("InterpolatedBuffer, " + std::to_string(thread_count) + " threads", measure([&] {
+        buffer.evaluate(output.data(), pool);
+        doNotOptimize(output.data());
+    }, value_count, 0.5));
+
+    SimulatedClock::disable();
+}
+
+}
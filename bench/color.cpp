@@ -0,0 +1,50 @@
+#include <vector>
+#include "bench.hpp"
+#include "peztool/utils/packed_color.hpp"
+
+
+namespace bench
+{
+
+using pez::PackedColor;
+
+void runColor()
+{
+    constexpr size_t color_count = 10'000;
+    std::cout << "--- Color blending (" << color_count << " colors) ---" << std::endl;
+    std::vector<PackedColor> start(color_count);
+    std::vector<PackedColor> target(color_count);
+    std::vector<float> ratios(color_count);
+    std::vector<pez::BlendWeight> weights(color_count);
+    std::vector<PackedColor> output(color_count);
+    for (size_t i{0}; i < color_count; ++i) {
+        auto const c = static_cast<uint8_t>(i);
+        start[i] = pez::packColor(c, static_cast<uint8_t>(255 - c), 0, 255);
+        target[i] = pez::packColor(0, c, static_cast<uint8_t>(c * 3), 128);
+        ratios[i] = static_cast<float>(i) / static_cast<float>(color_count);
+    }
+
+    // Float path previously used by InterpolatedData<sf::Color>, now only taken for overshooting ratios
+    report("Vec4f float blend", measure([&] {
+        for (size_t i{0}; i < color_count; ++i) {
+            output[i] = pez::extrapolatePacked(start[i], target[i], ratios[i]);
+        }
+        doNotOptimize(output.data());
+    }, color_count));
+    report("packed sRGB blend", measure([&] {
+        for (size_t i{0}; i < color_count; ++i) {
+            weights[i] = pez::getBlendWeight(ratios[i]);
+        }
+        pez::blendPacked(start.data(), target.data(), weights.data(), output.data(), color_count);
+        doNotOptimize(output.data());
+    }, color_count));
+    report("packed linear light blend", measure([&] {
+        for (size_t i{0}; i < color_count; ++i) {
+            weights[i] = pez::getBlendWeight(ratios[i]);
+        }
+        pez::blendPackedLinear(start.data(), target.data(), weights.data(), output.data(), color_count);
+        doNotOptimize(output.data());
+    }, color_count));
+}
+
+}
@@ -0,0 +1,57 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+#include "interpolated/compact_interpolated.hpp"
+
+
+namespace bench
+{
+
+template<typename TClock>
+void setTransition(Interpolated<Vec2, TClock>& value, TransitionFunction transition)
+{
+    value.transition = transition;
+}
+
+template<typename TClock>
+void setTransition(CompactInterpolated<Vec2, TClock>& value, TransitionFunction transition)
+{
+    value.setTransition(transition);
+}
+
+template<typename TInterpolated>
+void runCompactReads(std::string const& name, size_t value_count)
+{
+    std::vector<TInterpolated> values(value_count);
+    for (auto& value : values) {
+        value.setDuration(1000.0f);
+        setTransition(value, TransitionFunction::EaseOutBack);
+        value = Vec2{1.0f, 2.0f};
+    }
+    std::vector<Vec2> output(value_count);
+    report(name + " (" + std::to_string(sizeof(TInterpolated)) + " bytes)", measure([&] {
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count));
+}
+
+void runCompact()
+{
+    std::cout << "--- Compact storage ---" << std::endl;
+    std::cout << "    sizeof Interpolated<float>: " << sizeof(Interpolated<float>)
+              << ", CompactInterpolated<float>: " << sizeof(CompactInterpolated<float>) << std::endl;
+    std::cout << "    sizeof Interpolated<Vec2>: " << sizeof(Interpolated<Vec2>)
+              << ", CompactInterpolated<Vec2>: " << sizeof(CompactInterpolated<Vec2>) << std::endl;
+
+    // Values in transition, read once per frame from a sampled clock
+    FrameClock::sample();
+    for (size_t const value_count : {size_t{10'000}, size_t{4'000'000}}) {
+        std::cout << "    " << value_count << " Vec2 values in transition, EaseOutBack" << std::endl;
+        runCompactReads<Interpolated<Vec2, FrameClock>>("Interpolated", value_count);
+        runCompactReads<CompactInterpolated<Vec2, FrameClock>>("CompactInterpolated", value_count);
+    }
+}
+
+}
@@ -0,0 +1,64 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include "bench.hpp"
+#include "interpolated/concurrent_interpolated.hpp"
+
+
+namespace bench
+{
+
+void runConcurrent()
+{
+    constexpr size_t value_count = 1024;
+    std::cout << "--- ConcurrentInterpolated<Vec2> reads (" << value_count << " values) ---" << std::endl;
+    std::vector<std::unique_ptr<ConcurrentInterpolated<Vec2>>> values(value_count);
+    for (auto& value : values) {
+        value = std::make_unique<ConcurrentInterpolated<Vec2>>();
+        value->setDuration(1000.0f);
+        *value = Vec2{1.0f, 1.0f};
+    }
+
+    // Reference without synchronization
+    std::vector<Interpolated<Vec2>> plain_values(value_count);
+    for (auto& value : plain_values) {
+        value.setDuration(1000.0f);
+        value = Vec2{1.0f, 1.0f};
+    }
+    report("Interpolated, single thread", measure([&] {
+        for (auto const& value : plain_values) {
+            doNotOptimize(value.getValue());
+        }
+    }, value_count));
+
+    // Written values always have x == y, any other read is torn
+    uint64_t torn_reads{0};
+    auto const read_all = [&] {
+        for (auto const& value : values) {
+            Vec2 const v = *value;
+            torn_reads += (v.x != v.y);
+            doNotOptimize(v);
+        }
+    };
+    report("ConcurrentInterpolated, no writer", measure(read_all, value_count));
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> writes{0};
+    std::thread writer{[&] {
+        float k{0.0f};
+        while (running.load(std::memory_order_relaxed)) {
+            k += 1.0f;
+            for (auto& value : values) {
+                *value = Vec2{k, k};
+            }
+            writes.fetch_add(value_count, std::memory_order_relaxed);
+        }
+    }};
+    report("ConcurrentInterpolated, concurrent writer", measure(read_all, value_count));
+    running = false;
+    writer.join();
+    std::cout << "    writes: " << writes.load() << ", torn reads: " << torn_reads << std::endl;
+}
+
+}
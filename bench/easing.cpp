@@ -0,0 +1,78 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/functions.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr size_t value_count = 100'000;
+
+struct NamedTransition
+{
+    char const*        name;
+    TransitionFunction transition;
+};
+
+constexpr NamedTransition transitions[]{
+    {"Linear", TransitionFunction::Linear},
+    {"EaseInOutExponential", TransitionFunction::EaseInOutExponential},
+    {"EaseOutBack", TransitionFunction::EaseOutBack},
+    {"EaseInBack", TransitionFunction::EaseInBack},
+    {"EaseOutElastic", TransitionFunction::EaseOutElastic},
+};
+
+char const* getLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SimdLevel::Sse:
+            return "SSE";
+        case SimdLevel::Avx2:
+            return "AVX2";
+        case SimdLevel::Avx512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+    }
+}
+
+}
+
+void runEasing()
+{
+    std::cout << "--- Batch easing (" << value_count << " values) ---" << std::endl;
+    std::vector<float> t(value_count);
+    std::vector<float> output(value_count);
+    for (size_t i{0}; i < value_count; ++i) {
+        t[i] = static_cast<float>(i) / static_cast<float>(value_count);
+    }
+
+    SimdLevel const initial_level = getSimdLevel();
+    for (NamedTransition const& named : transitions) {
+        // Per value getRatio calls as a reference
+        double const scalar_ns = measure([&] {
+            for (size_t i{0}; i < value_count; ++i) {
+                output[i] = getRatio(t[i], named.transition);
+            }
+            doNotOptimize(output.data());
+        }, value_count);
+        report(std::string{"getRatio "} + named.name, scalar_ns);
+
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (setSimdLevel(level) != level) {
+                continue;
+            }
+            double const ns = measure([&] {
+                getRatios(t.data(), output.data(), value_count, named.transition);
+                doNotOptimize(output.data());
+            }, value_count);
+            report(std::string{"getRatios "} + getLevelName(level) + " " + named.name, ns);
+        }
+        setSimdLevel(initial_level);
+    }
+}
+
+}
@@ -0,0 +1,97 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+
+
+namespace
+{
+
+/// A polyline with arithmetic operators, each operation allocates a new one
+struct Polyline
+{
+    std::vector<float> coordinates;
+};
+
+Polyline operator+(Polyline const& a, Polyline const& b)
+{
+    Polyline result{a.coordinates};
+    for (size_t i{0}; i < result.coordinates.size(); ++i) {
+        result.coordinates[i] += b.coordinates[i];
+    }
+    return result;
+}
+
+Polyline operator-(Polyline const& a, Polyline const& b)
+{
+    Polyline result{a.coordinates};
+    for (size_t i{0}; i < result.coordinates.size(); ++i) {
+        result.coordinates[i] -= b.coordinates[i];
+    }
+    return result;
+}
+
+Polyline operator*(Polyline const& a, float f)
+{
+    Polyline result{a.coordinates};
+    for (float& coordinate : result.coordinates) {
+        coordinate *= f;
+    }
+    return result;
+}
+
+}
+
+namespace bench
+{
+
+namespace
+{
+
+template<typename TCallback>
+void reportAllocations(TCallback&& callback)
+{
+    constexpr uint64_t call_count = 1000;
+    uint64_t const initial_count = getAllocationCount();
+    for (uint64_t i{0}; i < call_count; ++i) {
+        callback();
+    }
+    std::cout << "    allocations per read: " << std::setprecision(1)
+              << static_cast<double>(getAllocationCount() - initial_count) / call_count << std::endl;
+}
+
+}
+
+void runHeavy()
+{
+    constexpr size_t point_count = 1'000;
+    std::cout << "--- Interpolated shape of " << point_count << " points ---" << std::endl;
+    std::vector<float> const start(2 * point_count, 0.0f);
+    std::vector<float> const end(2 * point_count, 1.0f);
+    FrameClock::sample();
+
+    Interpolated<Polyline, FrameClock> polyline{Polyline{start}};
+    polyline.setDuration(1000.0f);
+    polyline = Polyline{end};
+    Polyline polyline_output;
+    auto const read_polyline = [&] {
+        FrameClock::sample();
+        polyline_output = polyline;
+        doNotOptimize(polyline_output.coordinates.data());
+    };
+    report("operators, read", measure(read_polyline, 1));
+    reportAllocations(read_polyline);
+
+    Interpolated<std::vector<float>, FrameClock> shape{start};
+    shape.setDuration(1000.0f);
+    shape = end;
+    std::vector<float> output;
+    auto const read_shape = [&] {
+        FrameClock::sample();
+        shape.getValue(output);
+        doNotOptimize(output.data());
+    };
+    report("lerpInto, read in place", measure(read_shape, 1));
+    reportAllocations(read_shape);
+}
+
+}
@@ -0,0 +1,133 @@
+#include <vector>
+#include <type_traits>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr size_t value_count = 100'000;
+/// Long enough for all values to stay in transition during the whole benchmark
+constexpr float duration = 1000.0f;
+
+CubicBezier const ease{0.25f, 0.1f, 0.25f, 1.0f};
+
+struct NamedTransition
+{
+    char const*        name;
+    TransitionFunction transition;
+};
+
+constexpr NamedTransition transitions[]{
+    {"None",                 TransitionFunction::None},
+    {"Linear",               TransitionFunction::Linear},
+    {"EaseInOutExponential", TransitionFunction::EaseInOutExponential},
+    {"EaseOutBack",          TransitionFunction::EaseOutBack},
+    {"EaseInBack",           TransitionFunction::EaseInBack},
+    {"EaseOutElastic",       TransitionFunction::EaseOutElastic},
+    {"CubicBezier",          TransitionFunction::CubicBezier},
+};
+
+template<typename T>
+T makeValue(size_t i)
+{
+    float const f = static_cast<float>(i);
+    if constexpr (std::is_same_v<T, float>) {
+        return f;
+    } else if constexpr (std::is_same_v<T, Vec2>) {
+        return {f, -f};
+    } else {
+        return {f, -f, 2.0f * f, 0.5f * f};
+    }
+}
+
+template<typename T>
+void runReads(std::string const& type_name, NamedTransition const& named)
+{
+    std::vector<Interpolated<T, FrameClock>> values(value_count);
+    FrameClock::sample();
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i].setDuration(duration);
+        if (named.transition == TransitionFunction::CubicBezier) {
+            values[i].setTransition(ease);
+        } else {
+            values[i].transition = named.transition;
+        }
+        values[i] = makeValue<T>(i);
+    }
+    std::vector<T> output(value_count);
+    report("read " + type_name + " " + named.name, measure([&] {
+        FrameClock::sample();
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count));
+}
+
+template<typename T>
+void runType(std::string const& type_name)
+{
+    for (NamedTransition const& named : transitions) {
+        runReads<T>(type_name, named);
+    }
+
+    // Every read queries the system clock
+    std::vector<Interpolated<T>> values(value_count);
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i].setDuration(duration);
+        values[i] = makeValue<T>(i);
+    }
+    std::vector<T> output(value_count);
+    report("read " + type_name + " Linear SteadyClock", measure([&] {
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count));
+
+    // Simulated time, reads do not query the system clock
+    SimulatedClock::enable();
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i] = makeValue<T>(i);
+    }
+    report("read " + type_name + " Linear SimulatedClock", measure([&] {
+        SimulatedClock::advance(1);
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count));
+    SimulatedClock::disable();
+
+    // A new target while in transition, the current value has to be evaluated
+    std::vector<Interpolated<T, FrameClock>> targets(value_count);
+    for (auto& value : targets) {
+        value.setDuration(duration);
+    }
+    float offset{0.0f};
+    report("setValue " + type_name, measure([&] {
+        FrameClock::sample();
+        offset += 1.0f;
+        for (size_t i{0}; i < value_count; ++i) {
+            targets[i] = makeValue<T>(i) * offset;
+        }
+        doNotOptimize(targets.data());
+    }, value_count));
+}
+
+}
+
+void runInterpolated()
+{
+    std::cout << "--- Interpolated<T> reads per transition with FrameClock (" << value_count << " values) ---" << std::endl;
+    runType<float>("float");
+    runType<Vec2>("Vec2");
+    runType<Vec4>("Vec4");
+}
+
+}
@@ -0,0 +1,94 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+#include "interpolated/interpolated_array.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr size_t value_count = 100'000;
+/// Long enough for all values to stay in transition during the whole benchmark
+constexpr float duration = 1000.0f;
+
+Vec2 getTarget(size_t i)
+{
+    auto const f = static_cast<float>(i);
+    return {f, 2.0f * f};
+}
+
+TransitionFunction getTransition(size_t i, bool mixed)
+{
+    if (!mixed) {
+        return TransitionFunction::EaseOutBack;
+    }
+    // Blocks of values sharing the same transition
+    constexpr TransitionFunction transitions[]{TransitionFunction::Linear,
+                                               TransitionFunction::EaseOutBack,
+                                               TransitionFunction::EaseInOutExponential,
+                                               TransitionFunction::EaseOutElastic};
+    return transitions[(i / 64) % 4];
+}
+
+template<typename TClock>
+void runVector(std::string const& name, bool mixed)
+{
+    std::vector<Interpolated<Vec2, TClock>> values(value_count);
+    TClock::sample();
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i].setDuration(duration);
+        values[i].transition = getTransition(i, mixed);
+        values[i] = getTarget(i);
+    }
+    std::vector<Vec2> output(value_count);
+    double const ns = measure([&] {
+        TClock::sample();
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count);
+    report(name, ns);
+}
+
+template<typename TClock>
+void runArray(std::string const& name, bool mixed)
+{
+    InterpolatedArray<Vec2, TClock> values(value_count);
+    TClock::sample();
+    for (size_t i{0}; i < value_count; ++i) {
+        values.setDuration(i, duration);
+        values.setTransition(i, getTransition(i, mixed));
+        values.setValue(i, getTarget(i));
+    }
+    std::vector<Vec2> output(value_count);
+    double const ns = measure([&] {
+        TClock::sample();
+        values.evaluate(output.data());
+        doNotOptimize(output.data());
+    }, value_count);
+    report(name, ns);
+}
+
+/// Steady clock wrapper with a no-op sample to share code with FrameClock
+struct SampledSteadyClock : SteadyClock
+{
+    static void sample() {}
+};
+
+}
+
+void runInterpolatedArray()
+{
+    std::cout << "--- InterpolatedArray vs std::vector<Interpolated> (" << value_count << " Vec2 values) ---" << std::endl;
+    runVector<SampledSteadyClock>("vector<Interpolated> SteadyClock EaseOutBack", false);
+    runVector<FrameClock>("vector<Interpolated> FrameClock EaseOutBack", false);
+    runArray<FrameClock>("InterpolatedArray EaseOutBack", false);
+    runVector<FrameClock>("vector<Interpolated> FrameClock mixed", true);
+    runArray<FrameClock>("InterpolatedArray mixed", true);
+}
+
+}
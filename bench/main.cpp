@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <cstring>
+#include "bench.hpp"
+
+
+namespace
+{
+
+struct Group
+{
+    char const* name;
+    void      (*run)();
+};
+
+constexpr Group groups[]{
+    {"interpolated",       bench::runInterpolated},
+    {"pez",                bench::runPez},
+    {"easing",             bench::runEasing},
+    {"transition_table",   bench::runTransitionTable},
+    {"static_transition",  bench::runStaticTransition},
+    {"settled",            bench::runSettled},
+    {"animation_manager",  bench::runAnimationManager},
+    {"compact",            bench::runCompact},
+    {"concurrent",         bench::runConcurrent},
+    {"color",              bench::runColor},
+    {"versioning",         bench::runVersioning},
+    {"vertices",           bench::runVertices},
+    {"heavy",              bench::runHeavy},
+    {"buffer",             bench::runBuffer},
+    {"thread_pool",        bench::runThreadPool},
+    {"interpolated_array", bench::runInterpolatedArray},
+};
+
+void printUsage()
+{
+    std::cout << "Usage: bench [options]\n"
+                 "  --filter <text>      Only runs the groups whose name contains <text>\n"
+                 "  --json <path>        Writes the results to <path> as JSON\n"
+                 "  --baseline <path>    Compares the results with a JSON file written by --json,\n"
+                 "                       the exit code is 1 if a result regressed\n"
+                 "  --threshold <ratio>  Slowdown above which a result is a regression, 0.1 by default\n"
+                 "  --list               Lists the groups\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string json_path;
+    std::string baseline_path;
+    double threshold = 0.1;
+    for (int i{1}; i < argc; ++i) {
+        bool const has_value = (i + 1 < argc);
+        if (!std::strcmp(argv[i], "--filter") && has_value) {
+            filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--json") && has_value) {
+            json_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--baseline") && has_value) {
+            baseline_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--threshold") && has_value) {
+            threshold = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--list")) {
+            for (auto const& group : groups) {
+                std::cout << group.name << std::endl;
+            }
+            return 0;
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    // Load the baseline first to fail early
+    std::vector<bench::Result> baseline;
+    if (!baseline_path.empty() && !bench::readJson(baseline_path, baseline)) {
+        std::cerr << "Cannot read baseline " << baseline_path << std::endl;
+        return 2;
+    }
+
+    for (auto const& group : groups) {
+        if (std::string{group.name}.find(filter) == std::string::npos) {
+            continue;
+        }
+        bench::setGroup(group.name);
+        group.run();
+    }
+
+    if (!json_path.empty() && !bench::writeJson(json_path, bench::getResults())) {
+        std::cerr << "Cannot write " << json_path << std::endl;
+        return 2;
+    }
+    if (!baseline_path.empty()) {
+        return bench::compare(bench::getResults(), baseline, threshold) ? 1 : 0;
+    }
+    return 0;
+}
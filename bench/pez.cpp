@@ -0,0 +1,134 @@
+#include <vector>
+#include <type_traits>
+#include "bench.hpp"
+
+#if defined(BENCH_WITH_PEZ)
+#include "peztool/utils/interpolation/interpolated_value.hpp"
+#include "peztool/utils/interpolation/standard_interpolated_value.hpp"
+#endif
+
+
+namespace bench
+{
+
+#if defined(BENCH_WITH_PEZ)
+
+namespace
+{
+
+constexpr size_t value_count = 100'000;
+
+struct NamedFunction
+{
+    char const*                name;
+    pez::InterpolationFunction function;
+};
+
+constexpr NamedFunction functions[]{
+    {"Linear",               pez::InterpolationFunction::Linear},
+    {"EaseInOutExponential", pez::InterpolationFunction::EaseInOutExponential},
+    {"EaseInOutQuint",       pez::InterpolationFunction::EaseInOutQuint},
+    {"EaseOutBack",          pez::InterpolationFunction::EaseOutBack},
+    {"EaseOutElastic",       pez::InterpolationFunction::EaseOutElastic},
+};
+
+template<typename T>
+T makeValue(size_t i)
+{
+    float const f = static_cast<float>(i);
+    if constexpr (std::is_same_v<T, float>) {
+        return f;
+    } else if constexpr (std::is_same_v<T, Vec4f>) {
+        return {f, -f, 2.0f * f, 0.5f * f};
+    } else {
+        auto const c = static_cast<uint8_t>(i);
+        return sf::Color{c, static_cast<uint8_t>(255 - c), static_cast<uint8_t>(c * 3), 255};
+    }
+}
+
+/// Reads @p values in the middle of their transition, the application time is moved accordingly
+template<typename TValue, typename T>
+void runReads(std::string const& name, std::vector<TValue>& values)
+{
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i] = makeValue<T>(i);
+    }
+    // Values have a one second transition
+    pez::Time::advance(0.5f);
+    std::vector<T> output(value_count);
+    report(name, measure([&] {
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count));
+}
+
+template<typename TValue, typename T>
+void runSetValue(std::string const& name)
+{
+    std::vector<TValue> values(value_count);
+    float offset{0.0f};
+    report(name, measure([&] {
+        pez::Time::advance(0.001f);
+        offset += 1.0f;
+        for (size_t i{0}; i < value_count; ++i) {
+            values[i] = makeValue<T>(i + static_cast<size_t>(offset));
+        }
+        doNotOptimize(values.data());
+    }, value_count));
+}
+
+template<typename T>
+void runType(std::string const& type_name)
+{
+    for (NamedFunction const& named : functions) {
+        std::vector<pez::InterpolatedValue<T>> old_values(value_count);
+        for (auto& value : old_values) {
+            value.setInterpolation(named.function);
+        }
+        runReads<pez::InterpolatedValue<T>, T>("InterpolatedValue read " + type_name + " " + named.name, old_values);
+
+        std::vector<pez::InterpolatedData<T>> values(value_count);
+        for (auto& value : values) {
+            value.setInterpolationFunction(named.function);
+        }
+        runReads<pez::InterpolatedData<T>, T>("InterpolatedData read " + type_name + " " + named.name, values);
+    }
+    runSetValue<pez::InterpolatedValue<T>, T>("InterpolatedValue setValue " + type_name);
+    runSetValue<pez::InterpolatedData<T>, T>("InterpolatedData setValue " + type_name);
+}
+
+}
+
+void runPez()
+{
+    std::cout << "--- pez::InterpolatedValue and pez::InterpolatedData (" << value_count << " values) ---" << std::endl;
+    std::cout << "    sizeof InterpolatedData<float>: " << sizeof(pez::InterpolatedData<float>)
+              << ", InterpolatedData<Vec4f>: " << sizeof(pez::InterpolatedData<Vec4f>)
+              << ", InterpolatedData<sf::Color>: " << sizeof(pez::InterpolatedData<sf::Color>) << std::endl;
+    runType<float>("float");
+    runType<Vec4f>("Vec4f");
+
+    using InterpolatedColor = pez::InterpolatedData<sf::Color>;
+    for (auto const mode : {InterpolatedColor::BlendMode::Srgb, InterpolatedColor::BlendMode::Linear}) {
+        std::vector<InterpolatedColor> colors(value_count);
+        for (auto& color : colors) {
+            color.setBlendMode(mode);
+        }
+        bool const linear = (mode == InterpolatedColor::BlendMode::Linear);
+        runReads<InterpolatedColor, sf::Color>(linear ? "InterpolatedData read Color linear" : "InterpolatedData read Color sRGB", colors);
+    }
+    runSetValue<InterpolatedColor, sf::Color>("InterpolatedData setValue Color");
+}
+
+#else
+
+void runPez()
+{
+    std::cout << "--- pez::InterpolatedValue and pez::InterpolatedData skipped, SFML headers not found ---" << std::endl;
+}
+
+#endif
+
+}
@@ -0,0 +1,127 @@
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+#include <sstream>
+#include "bench.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+std::string s_group;
+std::vector<Result> s_results;
+
+std::string escape(std::string const& str)
+{
+    std::string result;
+    for (char const c : str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+
+/// Reads the string starting after the opening quote at @p position
+std::string readString(std::string const& json, size_t& position)
+{
+    std::string result;
+    while (position < json.size() && json[position] != '"') {
+        if (json[position] == '\\' && position + 1 < json.size()) {
+            ++position;
+        }
+        result += json[position++];
+    }
+    ++position;
+    return result;
+}
+
+}
+
+void setGroup(std::string const& group)
+{
+    s_group = group;
+}
+
+void report(std::string const& name, double ns_per_op)
+{
+    std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << ns_per_op << " ns/op" << std::endl;
+    s_results.push_back({s_group.empty() ? name : s_group + "/" + name, ns_per_op});
+}
+
+std::vector<Result> const& getResults()
+{
+    return s_results;
+}
+
+bool writeJson(std::string const& path, std::vector<Result> const& results)
+{
+    std::ofstream file{path};
+    if (!file) {
+        return false;
+    }
+    file << "{\n  \"results\": [";
+    for (size_t i{0}; i < results.size(); ++i) {
+        Result const& result = results[i];
+        file << (i ? "," : "") << "\n    {\"name\": \"" << escape(result.name) << "\", "
+             << std::defaultfloat << std::setprecision(6) << "\"ns_per_op\": " << result.ns_per_op << ", "
+             << std::fixed << std::setprecision(0) << "\"ops_per_second\": " << (result.ns_per_op > 0.0 ? 1e9 / result.ns_per_op : 0.0) << "}";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+bool readJson(std::string const& path, std::vector<Result>& results)
+{
+    std::ifstream file{path};
+    if (!file) {
+        return false;
+    }
+    std::stringstream stream;
+    stream << file.rdbuf();
+    std::string const json = stream.str();
+    // Only the format produced by writeJson is supported: each name is followed by its time
+    std::string const name_key = "\"name\": \"";
+    std::string const time_key = "\"ns_per_op\": ";
+    size_t position = json.find(name_key);
+    while (position != std::string::npos) {
+        position += name_key.size();
+        Result result;
+        result.name = readString(json, position);
+        size_t const time_position = json.find(time_key, position);
+        if (time_position == std::string::npos) {
+            return false;
+        }
+        result.ns_per_op = std::strtod(json.c_str() + time_position + time_key.size(), nullptr);
+        results.push_back(result);
+        position = json.find(name_key, time_position);
+    }
+    return true;
+}
+
+uint32_t compare(std::vector<Result> const& results, std::vector<Result> const& baseline, double threshold)
+{
+    std::cout << "--- Comparison with baseline (threshold " << std::setprecision(0) << threshold * 100.0 << "%) ---" << std::endl;
+    uint32_t regressions{0};
+    for (Result const& result : results) {
+        auto const it = std::find_if(baseline.begin(), baseline.end(), [&](Result const& r) { return r.name == result.name; });
+        if (it == baseline.end()) {
+            std::cout << std::left << std::setw(72) << result.name << "  new" << std::endl;
+            continue;
+        }
+        double const change = result.ns_per_op / it->ns_per_op - 1.0;
+        bool const regression = change > threshold;
+        regressions += regression;
+        std::cout << std::left << std::setw(72) << result.name << std::right << std::showpos << std::setprecision(1)
+                  << std::setw(8) << change * 100.0 << "%" << std::noshowpos << (regression ? "  REGRESSION" : "") << std::endl;
+    }
+    std::cout << regressions << " regression(s)" << std::endl;
+    return regressions;
+}
+
+}
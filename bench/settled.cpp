@@ -0,0 +1,62 @@
+#include <vector>
+#include <thread>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+
+
+namespace bench
+{
+
+void runSettled()
+{
+    constexpr size_t value_count = 100'000;
+    std::cout << "--- Interpolated<float> reads with SteadyClock (" << value_count << " values) ---" << std::endl;
+    std::vector<Interpolated<float>> values(value_count);
+    std::vector<float> output(value_count);
+    auto const read_all = [&] {
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    };
+
+    // Instant transitions, values finished unread stay unsettled but the counter is idle
+    for (auto& value : values) {
+        value.setDuration(1e-9f);
+        value = 2.0f;
+    }
+    std::cout << "    finished, not read: unsettled: " << TransitionCounter::getUnsettledCount() << ", idle: " << TransitionCounter::isIdle() << std::endl;
+    // The first read settles values
+    read_all();
+    std::cout << "    finished, read: unsettled: " << TransitionCounter::getUnsettledCount() << ", idle: " << TransitionCounter::isIdle() << std::endl;
+    report("settled", measure(read_all, value_count));
+
+    // Long transitions, every read has to query the clock
+    for (auto& value : values) {
+        value.setDuration(1000.0f);
+        value = 1.0f;
+    }
+    std::cout << "    in transition: unsettled: " << TransitionCounter::getUnsettledCount() << ", idle: " << TransitionCounter::isIdle() << std::endl;
+    report("in transition", measure(read_all, value_count));
+
+    // Targets set from every thread, the counter must not make them share a cache line
+    uint32_t const thread_count = std::max(1u, std::thread::hardware_concurrency());
+    constexpr size_t set_count = 200'000;
+    report("setValue from every thread", measure([&] {
+        std::vector<std::thread> threads;
+        for (uint32_t i{0}; i < thread_count; ++i) {
+            threads.emplace_back([] {
+                Interpolated<float> value{0.0f};
+                for (size_t k{0}; k < set_count; ++k) {
+                    value = static_cast<float>(k);
+                }
+                doNotOptimize(value);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }, set_count * thread_count));
+}
+
+}
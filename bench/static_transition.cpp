@@ -0,0 +1,60 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr size_t value_count = 100'000;
+/// Long enough for all values to stay in transition during the whole benchmark
+constexpr float duration = 1000.0f;
+
+template<typename TInterpolated>
+double measureReads(std::vector<TInterpolated>& values)
+{
+    FrameClock::sample();
+    for (size_t i{0}; i < value_count; ++i) {
+        values[i].setDuration(duration);
+        values[i] = static_cast<float>(i);
+    }
+    std::vector<float> output(value_count);
+    return measure([&] {
+        FrameClock::sample();
+        for (size_t i{0}; i < value_count; ++i) {
+            output[i] = values[i];
+        }
+        doNotOptimize(output.data());
+    }, value_count);
+}
+
+template<TransitionFunction TTransition>
+void runTransition(char const* name)
+{
+    std::vector<Interpolated<float, FrameClock>> dynamic_values(value_count);
+    for (auto& value : dynamic_values) {
+        value.transition = TTransition;
+    }
+    report(std::string{"dynamic "} + name, measureReads(dynamic_values));
+
+    std::vector<StaticInterpolated<float, TTransition, FrameClock>> static_values(value_count);
+    report(std::string{"static "} + name, measureReads(static_values));
+}
+
+}
+
+void runStaticTransition()
+{
+    std::cout << "--- Interpolated<float> runtime vs compile time transition (" << value_count << " values) ---" << std::endl;
+    runTransition<TransitionFunction::None>("None");
+    runTransition<TransitionFunction::Linear>("Linear");
+    runTransition<TransitionFunction::EaseInOutExponential>("EaseInOutExponential");
+    runTransition<TransitionFunction::EaseOutBack>("EaseOutBack");
+    runTransition<TransitionFunction::EaseInBack>("EaseInBack");
+    runTransition<TransitionFunction::EaseOutElastic>("EaseOutElastic");
+}
+
+}
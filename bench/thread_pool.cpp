@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "bench.hpp"
+#include "peztool/utils/thread_pool.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** Returns the median delay between addTask and the start of the task on a worker, @p pause elapsing before each task.
+ *  The caller waits on a flag instead of waitForCompletion, which would let it run the task itself.
+ */
+double measureWakeLatency(pez::ThreadPool& pool, std::chrono::microseconds pause, uint32_t round_count)
+{
+    std::vector<double> latencies;
+    latencies.reserve(round_count);
+    for (uint32_t i{0}; i < round_count; ++i) {
+        if (pause.count()) {
+            std::this_thread::sleep_for(pause);
+        }
+        Clock::time_point started;
+        std::atomic<bool> done{false};
+        Clock::time_point const submitted = Clock::now();
+        pool.addTask([&started, &done] {
+            started = Clock::now();
+            done.store(true, std::memory_order_release);
+        });
+        while (!done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        latencies.push_back(std::chrono::duration<double, std::nano>(started - submitted).count());
+    }
+    // The last task may still be finishing after setting its flag
+    pool.waitForCompletion();
+    std::nth_element(latencies.begin(), latencies.begin() + round_count / 2, latencies.end());
+    return latencies[round_count / 2];
+}
+
+/// The queue used by ThreadPool before pez::Task and pez::MpmcQueue, kept as a reference
+struct MutexTaskQueue
+{
+    std::queue<std::function<void()>> tasks;
+    std::mutex                        mutex;
+
+    bool tryPush(std::function<void()>&& task)
+    {
+        std::lock_guard<std::mutex> lock_guard{mutex};
+        tasks.push(std::move(task));
+        return true;
+    }
+
+    bool tryPop(std::function<void()>& task)
+    {
+        std::lock_guard<std::mutex> lock_guard{mutex};
+        if (tasks.empty()) {
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop();
+        return true;
+    }
+};
+
+/// Moves @p task_count tasks through @p queue with @p thread_count producers and as many consumers, returns the time per task
+template<typename TTask, typename TQueue>
+double measureQueue(TQueue& queue, uint32_t thread_count, uint32_t task_count)
+{
+    return measure([&] {
+        std::atomic<uint32_t> executed{0};
+        std::vector<std::thread> threads;
+        for (uint32_t i{0}; i < thread_count; ++i) {
+            threads.emplace_back([&] {
+                for (uint32_t k{0}; k < task_count / thread_count; ++k) {
+                    // Same capture size as a parallelFor helper
+                    TTask task{[&executed, &queue] { executed.fetch_add(1, std::memory_order_relaxed); doNotOptimize(queue); }};
+                    while (!queue.tryPush(std::move(task))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            threads.emplace_back([&] {
+                TTask task;
+                for (uint32_t k{0}; k < task_count / thread_count; ++k) {
+                    while (!queue.tryPop(task)) {
+                        std::this_thread::yield();
+                    }
+                    task();
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }, task_count);
+}
+
+/// Reports the time per task and the matching throughput
+void reportTaskRate(std::string const& name, double ns_per_task)
+{
+    report(name, ns_per_task);
+    std::cout << "    " << std::setprecision(3) << 1e3 / ns_per_task << " M tasks/s" << std::endl;
+}
+
+}
+
+void runThreadPool()
+{
+    uint32_t const thread_count = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "--- ThreadPool (" << thread_count << " workers) ---" << std::endl;
+    pez::ThreadPool pool{thread_count};
+
+    // Many tiny tasks, the cost is dominated by the scheduling
+    constexpr uint32_t task_count = 10'000;
+    std::atomic<uint32_t> executed{0};
+    report("tiny tasks from the caller", measure([&] {
+        for (uint32_t i{0}; i < task_count; ++i) {
+            pool.addTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.waitForCompletion();
+    }, task_count));
+    uint64_t const allocation_count = getAllocationCount();
+    for (uint32_t i{0}; i < task_count; ++i) {
+        pool.addTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.waitForCompletion();
+    std::cout << "    allocations per task: " << std::setprecision(2)
+              << static_cast<double>(getAllocationCount() - allocation_count) / task_count << std::endl;
+    report("tiny tasks from workers", measure([&] {
+        constexpr uint32_t spawner_count = 16;
+        for (uint32_t i{0}; i < spawner_count; ++i) {
+            pool.addTask([&pool, &executed] {
+                for (uint32_t k{0}; k < task_count / spawner_count; ++k) {
+                    pool.addTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+                }
+            });
+        }
+        pool.waitForCompletion();
+    }, task_count));
+    doNotOptimize(executed);
+
+    // Per element cost growing with the index, equal batches leave the first workers idle
+    constexpr uint32_t element_count = 100'000;
+    std::vector<float> elements(element_count, 1.0f);
+    auto const process = [&elements](size_t start, size_t end) {
+        for (size_t i{start}; i < end; ++i) {
+            float value = elements[i];
+            for (size_t k{0}; k < i / 4096; ++k) {
+                value = value * 0.999f + 0.001f;
+            }
+            elements[i] = value;
+        }
+    };
+    report("dispatch, uneven cost", measure([&] {
+        pool.dispatch(element_count, process);
+    }, element_count));
+    report("dispatch, fewer elements than workers", measure([&] {
+        pool.dispatch(2, process);
+    }, 1));
+
+    // Shared queue alone, std::function under a mutex against pez::Task in the lock-free ring
+    constexpr uint32_t queue_task_count = 100'000;
+    for (uint32_t const thread_count : {1u, 2u}) {
+        std::string const threads = std::to_string(thread_count) + " producers / " + std::to_string(thread_count) + " consumers";
+        MutexTaskQueue mutex_queue;
+        reportTaskRate("mutex std::function queue, " + threads, measureQueue<std::function<void()>>(mutex_queue, thread_count, queue_task_count));
+        pez::MpmcQueue<pez::Task> ring{pez::ThreadPool::queue_capacity};
+        reportTaskRate("MpmcQueue<Task>, " + threads, measureQueue<pez::Task>(ring, thread_count, queue_task_count));
+    }
+
+    // A frame batch added while a long background job runs or is still queued
+    auto const measureFrame = [&pool](bool use_group, bool wait_for_background) {
+        std::atomic<bool> background_started{false};
+        pool.addTask([&background_started] {
+            background_started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        });
+        while (wait_for_background && !background_started) {
+            std::this_thread::yield();
+        }
+        auto const start = Clock::now();
+        pez::TaskGroup frame;
+        for (uint32_t i{0}; i < 64; ++i) {
+            if (use_group) {
+                pool.addTask(frame, [] {});
+            } else {
+                pool.addTask([] {});
+            }
+        }
+        if (use_group) {
+            pool.wait(frame);
+        } else {
+            pool.waitForCompletion();
+        }
+        double const elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        // The background job references background_started
+        pool.waitForCompletion();
+        return elapsed;
+    };
+    report("frame during a background job, global wait", measureFrame(false, true));
+    report("frame during a background job, TaskGroup", measureFrame(true, true));
+    report("frame behind a pending background job, TaskGroup", measureFrame(true, false));
+
+    report("wake latency, busy pool", measureWakeLatency(pool, std::chrono::microseconds{0}, 10'000));
+    report("wake latency, idle pool", measureWakeLatency(pool, std::chrono::microseconds{2'000}, 200));
+
+    // Process CPU time while the pool has nothing to do, 1 is a full core
+    constexpr auto idle_duration = std::chrono::milliseconds{250};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    std::clock_t const cpu_start = std::clock();
+    std::this_thread::sleep_for(idle_duration);
+    double const cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    std::cout << "    idle CPU usage: " << std::setprecision(3)
+              << cpu_seconds / std::chrono::duration<double>(idle_duration).count() << " cores" << std::endl;
+}
+
+}
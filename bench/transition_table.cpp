@@ -0,0 +1,63 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/transition_table.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr size_t value_count = 100'000;
+
+struct NamedTransition
+{
+    char const*        name;
+    TransitionFunction transition;
+};
+
+constexpr NamedTransition transitions[]{
+    {"EaseInOutExponential", TransitionFunction::EaseInOutExponential},
+    {"EaseOutBack", TransitionFunction::EaseOutBack},
+    {"EaseOutElastic", TransitionFunction::EaseOutElastic},
+};
+
+}
+
+void runTransitionTable()
+{
+    std::cout << "--- Transition tables vs analytic functions (" << value_count << " values) ---" << std::endl;
+    std::vector<float> t(value_count);
+    std::vector<float> output(value_count);
+    for (size_t i{0}; i < value_count; ++i) {
+        // Spread values to avoid perfectly sequential table accesses
+        t[i] = static_cast<float>((i * 7919) % value_count) / static_cast<float>(value_count);
+    }
+
+    for (NamedTransition const& named : transitions) {
+        double const analytic_ns = measure([&] {
+            for (size_t i{0}; i < value_count; ++i) {
+                output[i] = getAnalyticRatio(t[i], named.transition);
+            }
+            doNotOptimize(output.data());
+        }, value_count);
+        report(std::string{"analytic "} + named.name, analytic_ns);
+
+        for (uint32_t const resolution : {64u, 256u, 1024u, 4096u}) {
+            TransitionTable const table{named.transition, resolution};
+            double const ns = measure([&] {
+                for (size_t i{0}; i < value_count; ++i) {
+                    output[i] = table.sample(t[i]);
+                }
+                doNotOptimize(output.data());
+            }, value_count);
+            report(std::string{"table "} + std::to_string(resolution) + " " + named.name, ns);
+            std::cout << "    max error " << std::scientific << table.getMaxError() << std::fixed
+                      << ", " << table.getByteSize() << " bytes" << std::endl;
+        }
+        std::cout << "    resolution for 1e-4: " << TransitionTable::getResolutionFor(named.transition, 1e-4f) << std::endl;
+    }
+}
+
+}
@@ -0,0 +1,66 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+/// Writes the 4 corners of a rectangle, stands for rebuilding geometry from a value
+void buildQuad(Vec4 const& rect, Vec2* vertices)
+{
+    vertices[0] = {rect.x, rect.y};
+    vertices[1] = {rect.x + rect.z, rect.y};
+    vertices[2] = {rect.x + rect.z, rect.y + rect.w};
+    vertices[3] = {rect.x, rect.y + rect.w};
+}
+
+}
+
+void runVersioning()
+{
+    constexpr size_t value_count = 100'000;
+    constexpr size_t moving_count = 1'000;
+    std::cout << "--- Geometry rebuild, " << moving_count << " moving out of " << value_count << " Vec4 values ---" << std::endl;
+    std::vector<Interpolated<Vec4, FrameClock>> rects(value_count);
+    std::vector<Vec2> vertices(4 * value_count);
+    FrameClock::sample();
+    for (size_t i{0}; i < value_count; ++i) {
+        rects[i].setDuration(1000.0f);
+        rects[i] = Vec4{static_cast<float>(i), 0.0f, 10.0f, 10.0f};
+    }
+    // Wait for static values to settle, then set the moving ones
+    SimulatedClock::enable(FrameClock::getTime() + toTicks(2000.0f));
+    FrameClock::sample();
+    for (size_t i{0}; i < value_count; i += value_count / moving_count) {
+        rects[i] = Vec4{0.0f, static_cast<float>(i), 20.0f, 20.0f};
+    }
+
+    report("rebuild all", measure([&] {
+        SimulatedClock::advance(1);
+        FrameClock::sample();
+        for (size_t i{0}; i < value_count; ++i) {
+            buildQuad(rects[i], &vertices[4 * i]);
+        }
+        doNotOptimize(vertices.data());
+    }, value_count));
+
+    Tick last_update{0};
+    report("rebuild changed", measure([&] {
+        SimulatedClock::advance(1);
+        FrameClock::sample();
+        for (size_t i{0}; i < value_count; ++i) {
+            if (rects[i].hasChangedSince(last_update)) {
+                buildQuad(rects[i], &vertices[4 * i]);
+            }
+        }
+        last_update = FrameClock::getTime();
+        doNotOptimize(vertices.data());
+    }, value_count));
+    SimulatedClock::disable();
+}
+
+}
@@ -0,0 +1,98 @@
+#include <vector>
+#include "bench.hpp"
+#include "interpolated/interpolated.hpp"
+#include "interpolated/interpolated_array.hpp"
+
+
+namespace bench
+{
+
+namespace
+{
+
+/// Same layout as sf::Vertex
+struct Vertex
+{
+    Vec2     position;
+    uint32_t color{};
+    Vec2     tex_coords;
+};
+
+uint32_t toColor(Vec4 const& c)
+{
+    return static_cast<uint32_t>(c.x) | (static_cast<uint32_t>(c.y) << 8) | (static_cast<uint32_t>(c.z) << 16) | (static_cast<uint32_t>(c.w) << 24);
+}
+
+constexpr float half_size = 2.0f;
+
+/// Writes a quad centered on @p position
+void writeQuad(Vertex* vertices, Vec2 const& position, Vec4 const& color)
+{
+    uint32_t const packed = toColor(color);
+    vertices[0] = {{position.x - half_size, position.y - half_size}, packed, {}};
+    vertices[1] = {{position.x + half_size, position.y - half_size}, packed, {}};
+    vertices[2] = {{position.x + half_size, position.y + half_size}, packed, {}};
+    vertices[3] = {{position.x - half_size, position.y + half_size}, packed, {}};
+}
+
+/// Stands for an sf::RectangleShape: it stores its own state and generates its vertices on update
+struct Shape
+{
+    Vec2   position;
+    Vec4   color;
+    Vertex vertices[4];
+
+    void update()
+    {
+        writeQuad(vertices, position, color);
+    }
+};
+
+}
+
+void runVertices()
+{
+    constexpr size_t marker_count = 100'000;
+    std::cout << "--- Animated markers to vertices (" << marker_count << " quads) ---" << std::endl;
+    std::vector<Vertex> vertices(4 * marker_count);
+
+    // Per value objects copied into shapes, then into the vertex buffer
+    std::vector<Interpolated<Vec2, FrameClock>> positions(marker_count);
+    std::vector<Interpolated<Vec4, FrameClock>> colors(marker_count);
+    std::vector<Shape> shapes(marker_count);
+    FrameClock::sample();
+    for (size_t i{0}; i < marker_count; ++i) {
+        positions[i].setDuration(1000.0f);
+        colors[i].setDuration(1000.0f);
+        positions[i] = Vec2{static_cast<float>(i), 1.0f};
+        colors[i] = Vec4{255.0f, 128.0f, 0.0f, 255.0f};
+    }
+    report("Interpolated -> shape -> vertices", measure([&] {
+        FrameClock::sample();
+        for (size_t i{0}; i < marker_count; ++i) {
+            Shape& shape = shapes[i];
+            shape.position = positions[i];
+            shape.color = colors[i];
+            shape.update();
+            std::copy(shape.vertices, shape.vertices + 4, &vertices[4 * i]);
+        }
+        doNotOptimize(vertices.data());
+    }, marker_count));
+
+    // Arrays evaluated straight into the vertex buffer
+    InterpolatedArray<Vec2, FrameClock> position_array{marker_count};
+    InterpolatedArray<Vec4, FrameClock> color_array{marker_count};
+    for (size_t i{0}; i < marker_count; ++i) {
+        position_array.setDuration(i, 1000.0f);
+        color_array.setDuration(i, 1000.0f);
+        position_array.setValue(i, Vec2{static_cast<float>(i), 1.0f});
+        color_array.setValue(i, Vec4{255.0f, 128.0f, 0.0f, 255.0f});
+    }
+    report("evaluateInto vertices", measure([&] {
+        FrameClock::sample();
+        evaluateInto(vertices.data(), 4, writeQuad, position_array, color_array);
+        doNotOptimize(vertices.data());
+    }, marker_count));
+}
+
+}
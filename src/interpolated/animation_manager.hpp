@@ -0,0 +1,196 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "interpolated.hpp"
+
+
+template<typename TInterpolated>
+class AnimatedValue;
+
+
+/** Keeps track of the AnimatedValue currently in transition.
+ *  Values register themselves when a new target is set and are removed by @p update once their transition is over,
+ *  so the per frame work only depends on the number of moving values.
+ */
+template<typename TInterpolated>
+class AnimationManager
+{
+public:
+    using Value = AnimatedValue<TInterpolated>;
+
+    AnimationManager() = default;
+    AnimationManager(AnimationManager const&) = delete;
+    AnimationManager& operator=(AnimationManager const&) = delete;
+
+    /** Evaluates all the moving values and publishes them to their destination, if they have one.
+     *  Values whose transition is over publish their target one last time and leave the active set.
+     */
+    void update()
+    {
+        // Iterate backward so that swap removal does not skip values
+        for (size_t i{m_active.size()}; i--;) {
+            Value& value = *m_active[i];
+            value.publish();
+            if (!value.m_interpolated.isInTransition()) {
+                remove(value);
+            }
+        }
+    }
+
+    /// Returns the number of values currently in transition
+    [[nodiscard]]
+    size_t getActiveCount() const
+    {
+        return m_active.size();
+    }
+
+private:
+    friend class AnimatedValue<TInterpolated>;
+
+    /// The values currently in transition
+    std::vector<Value*> m_active;
+
+    void add(Value& value)
+    {
+        value.m_active_index = static_cast<uint32_t>(m_active.size());
+        m_active.push_back(&value);
+    }
+
+    void remove(Value& value)
+    {
+        // Swap with the last value to remove in constant time
+        Value* const last = m_active.back();
+        m_active[value.m_active_index] = last;
+        last->m_active_index = value.m_active_index;
+        m_active.pop_back();
+        value.m_active_index = Value::inactive;
+    }
+};
+
+
+/** An Interpolated value managed by an AnimationManager.
+ *  While it moves, the manager writes its current value into the bound destination on each update.
+ *  The manager keeps pointers to moving values so they can neither be copied nor moved.
+ */
+template<typename TInterpolated>
+class AnimatedValue
+{
+public:
+    using ValueType = typename TInterpolated::ValueType;
+
+    /// Creates a value starting at @p initial_value, @p destination receives the current value on updates
+    explicit
+    AnimatedValue(AnimationManager<TInterpolated>& manager, ValueType* destination = nullptr, ValueType const& initial_value = {})
+        : m_interpolated{initial_value}
+        , m_manager{&manager}
+    {
+        bind(destination);
+    }
+
+    AnimatedValue(AnimatedValue const&) = delete;
+    AnimatedValue& operator=(AnimatedValue const&) = delete;
+
+    ~AnimatedValue()
+    {
+        if (isActive()) {
+            m_manager->remove(*this);
+        }
+    }
+
+    /// Sets a new target value and registers the value to the manager if it was not moving
+    void setValue(ValueType const& new_value)
+    {
+        m_interpolated.setValue(new_value);
+        if (!isActive()) {
+            m_manager->add(*this);
+        }
+    }
+
+    /// Sets the destination updated by the manager and writes the current value to it
+    void bind(ValueType* destination)
+    {
+        m_destination = destination;
+        publish();
+    }
+
+    /// Returns the current value
+    [[nodiscard]]
+    ValueType getValue() const
+    {
+        return m_interpolated.getValue();
+    }
+
+    /// Sets the transition duration in seconds
+    void setDuration(float duration)
+    {
+        m_interpolated.setDuration(duration);
+    }
+
+    /// Sets the transition speed, the number of transitions per second
+    void setSpeed(float speed)
+    {
+        m_interpolated.setSpeed(speed);
+    }
+
+    /// Sets the transition function, or a CubicBezier that has to outlive this object
+    template<typename TTransitionArgument>
+    void setTransition(TTransitionArgument const& transition)
+    {
+        m_interpolated.setTransition(transition);
+    }
+
+    /// A temporary curve would be unregistered at the end of the call
+    void setTransition(CubicBezier&&) = delete;
+
+    /// Gives read access to the underlying value, targets have to be set through this object to be tracked
+    [[nodiscard]]
+    TInterpolated const& getInterpolated() const
+    {
+        return m_interpolated;
+    }
+
+    /// Returns true if the value is in the manager's active set
+    [[nodiscard]]
+    bool isActive() const
+    {
+        return m_active_index != inactive;
+    }
+
+    /// Cast operator to use this object directly as if it was of type T
+    [[nodiscard]]
+    operator ValueType() const
+    {
+        return getValue();
+    }
+
+    /// Assign operator to ease transitions
+    void operator=(ValueType const& new_value)
+    {
+        setValue(new_value);
+    }
+
+private:
+    friend class AnimationManager<TInterpolated>;
+
+    static constexpr uint32_t inactive = 0xFFFFFFFF;
+
+    /// The interpolated value
+    TInterpolated m_interpolated;
+    /// The manager tracking this value
+    AnimationManager<TInterpolated>* m_manager = nullptr;
+    /// Where to write the current value, can be null
+    ValueType* m_destination = nullptr;
+    /// The index in the manager's active set
+    uint32_t m_active_index = inactive;
+
+    /// Evaluates the current value and writes it to the destination if any, the read settles finished transitions
+    void publish()
+    {
+        if (m_destination) {
+            m_interpolated.getValue(*m_destination);
+        } else {
+            static_cast<void>(m_interpolated.getValue());
+        }
+    }
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+
+/** Timestamps are integer nanoseconds, their precision does not degrade with uptime
+ *  and durations are computed with an exact integer subtraction.
+ */
+using Tick = int64_t;
+
+/// The number of ticks in one second
+constexpr Tick ticks_per_second = 1'000'000'000;
+
+/// Converts a number of ticks to seconds
+constexpr float toSeconds(Tick ticks)
+{
+    return static_cast<float>(ticks) * (1.0f / static_cast<float>(ticks_per_second));
+}
+
+/// Converts a number of seconds to ticks
+constexpr Tick toTicks(float seconds)
+{
+    return static_cast<Tick>(static_cast<double>(seconds) * static_cast<double>(ticks_per_second));
+}
+
+/** Converts a duration in seconds to the inverse of its number of ticks, the factor turning elapsed ticks into progress.
+ *  Durations <= 0 give infinity: progress is then NaN at the start instant, so progress checks are written !(t < 1)
+ *  for such transitions to end immediately.
+ */
+constexpr float toInvDuration(float duration)
+{
+    return (duration > 0.0f) ? 1.0f / (duration * static_cast<float>(ticks_per_second)) : std::numeric_limits<float>::infinity();
+}
+
+
+/** Virtual time controlled by the application, for deterministic and faster than real time runs.
+ *  Once enabled, every clock policy reads it instead of the system clock: nothing moves until @p advance is called.
+ *  Values set before the switch keep timestamps from the previous time base, they should be settled or set again.
+ */
+struct SimulatedClock
+{
+    /// Makes all the clocks read the simulated time, starting at @p start_time
+    static void enable(Tick start_time = 0)
+    {
+        s_time.store(start_time, std::memory_order_relaxed);
+        s_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /// Goes back to the system clock
+    static void disable()
+    {
+        s_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Moves the simulated time forward by @p ticks
+    static void advance(Tick ticks)
+    {
+        s_time.fetch_add(ticks, std::memory_order_relaxed);
+    }
+
+    /// Returns the simulated time
+    [[nodiscard]]
+    static Tick getTime()
+    {
+        return s_time.load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<bool> s_enabled{false};
+    static inline std::atomic<Tick> s_time{0};
+};
+
+
+/** Time source reading the steady clock on every access.
+ *  This is the default policy, values are always up to date but each read costs a clock query.
+ *  The simulated time is returned instead when enabled.
+ */
+struct SteadyClock
+{
+    /// Returns stop watch time in nanoseconds, 64 bits cover centuries of uptime
+    [[nodiscard]]
+    static Tick getTime()
+    {
+        if (SimulatedClock::isEnabled()) {
+            return SimulatedClock::getTime();
+        }
+        auto const duration = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+};
+
+/** Time source returning a timestamp cached by the last call to @p sample.
+ *  The application samples it once per frame so all the reads performed during
+ *  this frame share the same time, which is both cheaper and consistent.
+ */
+struct FrameClock
+{
+    /// Caches the current time, has to be called once per frame by the application
+    static void sample()
+    {
+        s_time = SteadyClock::getTime();
+    }
+
+    /// Returns the time cached by the last call to @p sample
+    [[nodiscard]]
+    static Tick getTime()
+    {
+        return s_time;
+    }
+
+private:
+    /// The last sampled time
+    static inline Tick s_time{};
+};
@@ -0,0 +1,202 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+
+#include "clock.hpp"
+#include "functions.hpp"
+
+
+/** Registry of the transition durations used by CompactInterpolated, indexed with 16 bits.
+ *  Applications use a handful of distinct durations so the table stays small and hot in cache.
+ *  Durations can be registered from any thread, the table never moves so reads do not lock.
+ */
+struct CompactDurations
+{
+    /// The maximum number of distinct durations
+    static constexpr size_t max_count = 4096;
+
+    /// Returns the index of @p duration in seconds, registering it if needed. Asserts and returns 0 when full
+    static uint16_t getIndex(float duration)
+    {
+        float const inv_duration = toInvDuration(duration);
+        std::lock_guard<std::mutex> const lock{s_mutex};
+        auto const it = s_indices.find(inv_duration);
+        if (it != s_indices.end()) {
+            return it->second;
+        }
+        if (s_indices.size() == max_count) {
+            assert(false && "Too many distinct CompactInterpolated durations, increase CompactDurations::max_count");
+            return 0;
+        }
+        auto const index = static_cast<uint16_t>(s_indices.size());
+        s_inv_durations[index].store(inv_duration, std::memory_order_release);
+        s_indices.emplace(inv_duration, index);
+        return index;
+    }
+
+    /// Returns the inverse duration in ticks associated with @p index
+    [[nodiscard]]
+    static float getInvDuration(uint16_t index)
+    {
+        return s_inv_durations[index % max_count].load(std::memory_order_acquire);
+    }
+
+private:
+    /// Inverse durations in ticks, index 0 is the default 1 second duration
+    static inline std::atomic<float> s_inv_durations[max_count]{1.0f / static_cast<float>(ticks_per_second)};
+    /// The index of each registered inverse duration
+    static inline std::unordered_map<float, uint16_t> s_indices{{1.0f / static_cast<float>(ticks_per_second), uint16_t{0}}};
+    /// Protects s_indices and the registration of new durations
+    static inline std::mutex s_mutex;
+};
+
+
+/** Memory compact version of Interpolated for very large numbers of values.
+ *  The start time is stored as a 32 bits count of ~1ms quanta, the duration as a 16 bits index
+ *  in CompactDurations and the transition on 8 bits, whose high bit latches the settled state.
+ *  Interpolated<Vec2f> takes 40 bytes and CompactInterpolated<Vec2f> 24 bytes.
+ *  Values are not counted by TransitionCounter and CubicBezier is evaluated as Linear.
+ *  The quantized start time wraps after ~52 days: a value in transition not read for that long would restart.
+ */
+template<typename T, typename TClock = SteadyClock>
+struct CompactInterpolated
+{
+    /// The interpolated type
+    using ValueType = T;
+
+    /// Start times are stored in quanta of 2^20 ticks (~1.05ms)
+    static constexpr uint32_t quantum_shift = 20;
+
+    /// Initializes the value with @p initial_value
+    explicit
+    CompactInterpolated(T const& initial_value = {})
+        : m_start{initial_value}
+        , m_end{initial_value}
+    {}
+
+    CompactInterpolated(CompactInterpolated const& other)
+        : m_start{other.m_start}
+        , m_end{other.m_end}
+        , m_start_quantum{other.m_start_quantum}
+        , m_duration_index{other.m_duration_index}
+        , m_transition{other.m_transition.load(std::memory_order_relaxed)}
+    {}
+
+    CompactInterpolated& operator=(CompactInterpolated const& other)
+    {
+        m_start = other.m_start;
+        m_end = other.m_end;
+        m_start_quantum = other.m_start_quantum;
+        m_duration_index = other.m_duration_index;
+        m_transition.store(other.m_transition.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    /// Sets a new target value and resets transition
+    void setValue(T const& new_value)
+    {
+        // Settled values restart from their target, whatever the clock or the duration say now
+        m_start = getValue();
+        Tick const now = TClock::getTime();
+        m_end = new_value;
+        m_start_quantum = static_cast<uint32_t>(now >> quantum_shift);
+        m_transition.store(getTransitionBits() | in_transition_bit, std::memory_order_relaxed);
+    }
+
+    /// Returns the current value
+    [[nodiscard]]
+    T getValue() const
+    {
+        if (!isInTransition()) {
+            return m_end;
+        }
+        return getValue(TClock::getTime());
+    }
+
+    /// Sets the transition duration in seconds
+    void setDuration(float duration)
+    {
+        m_duration_index = CompactDurations::getIndex(duration);
+    }
+
+    /// Sets the transition function
+    void setTransition(TransitionFunction transition)
+    {
+        uint8_t const state = m_transition.load(std::memory_order_relaxed) & in_transition_bit;
+        m_transition.store(static_cast<uint8_t>(transition) | state, std::memory_order_relaxed);
+    }
+
+    /// Returns the transition function
+    [[nodiscard]]
+    TransitionFunction getTransition() const
+    {
+        return static_cast<TransitionFunction>(getTransitionBits());
+    }
+
+    /// Returns the target value
+    [[nodiscard]]
+    T const& getTarget() const
+    {
+        return m_end;
+    }
+
+    /// Returns true until a read observed the end of the current transition
+    [[nodiscard]]
+    bool isInTransition() const
+    {
+        return m_transition.load(std::memory_order_relaxed) & in_transition_bit;
+    }
+
+    /// Cast operator to use this object directly as if it was of type T
+    [[nodiscard]]
+    operator T() const
+    {
+        return getValue();
+    }
+
+    /// Assign operator to ease transitions
+    void operator=(T const& new_value)
+    {
+        setValue(new_value);
+    }
+
+private:
+    /// High bit of the transition byte, set while a transition is running
+    static constexpr uint8_t in_transition_bit = 0x80;
+
+    /// The value at the start of the transition
+    T m_start;
+    /// The target value, stored instead of a delta so that settled values are exact
+    T m_end;
+    /// The transition start time in quanta, wraps around
+    uint32_t m_start_quantum{};
+    /// Index of the duration in CompactDurations
+    uint16_t m_duration_index{};
+    /// The transition function and the in transition bit
+    mutable std::atomic<uint8_t> m_transition{static_cast<uint8_t>(TransitionFunction::Linear)};
+
+    [[nodiscard]]
+    uint8_t getTransitionBits() const
+    {
+        return m_transition.load(std::memory_order_relaxed) & ~in_transition_bit;
+    }
+
+    /// Returns the value at time @p now
+    [[nodiscard]]
+    T getValue(Tick now) const
+    {
+        // Unsigned arithmetic handles the wrap around of quanta, the current time keeps its full resolution
+        uint32_t const elapsed_quanta = static_cast<uint32_t>(now >> quantum_shift) - m_start_quantum;
+        Tick const elapsed = (static_cast<Tick>(elapsed_quanta) << quantum_shift) + (now & ((Tick{1} << quantum_shift) - 1));
+        float const t = static_cast<float>(elapsed) * CompactDurations::getInvDuration(m_duration_index);
+        if (!(t < 1.0f)) {
+            m_transition.fetch_and(static_cast<uint8_t>(~in_transition_bit), std::memory_order_relaxed);
+            return m_end;
+        }
+        T const delta{m_end - m_start};
+        return m_start + delta * getRatio(t, getTransition());
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "interpolated.hpp"
+
+
+/** Sequence lock publishing a trivially copyable @p TData from a single writer to any number of readers.
+ *  The data is stored in atomic words so that concurrent copies are not data races.
+ *  Writers never wait, readers retry only if a write happened during their copy.
+ */
+template<typename TData>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<TData>, "SeqLock data has to be trivially copyable");
+
+public:
+    explicit
+    SeqLock(TData const& data = {})
+    {
+        store(data);
+    }
+
+    /// Publishes @p data, only one thread at a time can store
+    void store(TData const& data)
+    {
+        uint64_t words[word_count]{};
+        std::memcpy(words, &data, sizeof(TData));
+        uint32_t const sequence = m_sequence.load(std::memory_order_relaxed);
+        // Odd sequence, readers know a write is in progress
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (uint32_t i{0}; i < word_count; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// Returns a consistent copy of the last published data
+    [[nodiscard]]
+    TData load() const
+    {
+        uint64_t words[word_count];
+        uint32_t sequence_before;
+        uint32_t sequence_after;
+        do {
+            sequence_before = m_sequence.load(std::memory_order_acquire);
+            for (uint32_t i{0}; i < word_count; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            sequence_after = m_sequence.load(std::memory_order_relaxed);
+        } while ((sequence_before & 1) || sequence_before != sequence_after);
+        TData data;
+        std::memcpy(&data, words, sizeof(TData));
+        return data;
+    }
+
+private:
+    static constexpr uint32_t word_count = (sizeof(TData) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    /// Incremented before and after each write
+    std::atomic<uint32_t> m_sequence{0};
+    /// The data, copied word by word
+    std::atomic<uint64_t> m_words[word_count];
+};
+
+
+/** Interpolated value written by one thread and read by others, for instance a logic thread and a render thread.
+ *  The transition state is published through a SeqLock so that readers never observe a torn state.
+ *  The writer keeps its own copy of the state, writes do not read the shared one.
+ *  @p T has to be trivially copyable and @p TClock thread safe, @p FrameClock is not since it is sampled by one thread.
+ *  Reads cannot settle the value: they do not latch the end of transitions and are not counted by TransitionCounter.
+ */
+template<typename T, typename TClock = SteadyClock>
+class ConcurrentInterpolated
+{
+public:
+    /// The interpolated type
+    using ValueType = T;
+
+    /// Initializes the value with @p initial_value
+    explicit
+    ConcurrentInterpolated(T const& initial_value = {})
+        : m_state{State{initial_value, initial_value}}
+        , m_shared{m_state}
+    {}
+
+    ConcurrentInterpolated(ConcurrentInterpolated const&) = delete;
+    ConcurrentInterpolated& operator=(ConcurrentInterpolated const&) = delete;
+
+    /// Sets a new target value and resets transition, writer thread only
+    void setValue(T const& new_value)
+    {
+        Tick const now = TClock::getTime();
+        m_state.start = m_state.getValue(now);
+        m_state.end = new_value;
+        m_state.start_time = now;
+        m_shared.store(m_state);
+    }
+
+    /// Sets the transition duration in seconds, writer thread only
+    void setDuration(float duration)
+    {
+        m_state.inv_duration = toInvDuration(duration);
+        m_shared.store(m_state);
+    }
+
+    /// Sets the transition function, writer thread only
+    void setTransition(TransitionFunction transition)
+    {
+        m_state.transition.transition = transition;
+        m_shared.store(m_state);
+    }
+
+    /// Uses @p bezier as transition, it has to outlive this object, writer thread only
+    void setTransition(CubicBezier const& bezier)
+    {
+        m_state.transition.setTransition(bezier);
+        m_shared.store(m_state);
+    }
+
+    /// A temporary curve would be unregistered at the end of the call
+    void setTransition(CubicBezier&&) = delete;
+
+    /// Returns the target value, writer thread only
+    [[nodiscard]]
+    T const& getTarget() const
+    {
+        return m_state.end;
+    }
+
+    /// Returns the current value, can be called from any thread
+    [[nodiscard]]
+    T getValue() const
+    {
+        return m_shared.load().getValue(TClock::getTime());
+    }
+
+    /// Cast operator to use this object directly as if it was of type T
+    [[nodiscard]]
+    operator T() const
+    {
+        return getValue();
+    }
+
+    /// Assign operator to ease transitions, writer thread only
+    void operator=(T const& new_value)
+    {
+        setValue(new_value);
+    }
+
+private:
+    /// Everything a read needs, published as a whole
+    struct State
+    {
+        T start{};
+        T end{};
+        Tick start_time{};
+        float inv_duration{1.0f / static_cast<float>(ticks_per_second)};
+        DynamicTransition transition{};
+
+        [[nodiscard]]
+        T getValue(Tick now) const
+        {
+            float const t = static_cast<float>(now - start_time) * inv_duration;
+            if (!(t < 1.0f)) {
+                return end;
+            }
+            T const delta{end - start};
+            return start + delta * transition.getTransitionRatio(t);
+        }
+    };
+
+    /// The writer copy of the state
+    State m_state;
+    /// The state seen by readers
+    SeqLock<State> m_shared;
+};
@@ -0,0 +1,141 @@
+#include "cubic_bezier.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+CubicBezier::CubicBezier(float x1, float y1, float x2, float y2)
+{
+    x1 = std::min(std::max(x1, 0.0f), 1.0f);
+    x2 = std::min(std::max(x2, 0.0f), 1.0f);
+    // Start and end points are (0, 0) and (1, 1)
+    m_cx = 3.0f * x1;
+    m_bx = 3.0f * (x2 - x1) - m_cx;
+    m_ax = 1.0f - m_cx - m_bx;
+    m_cy = 3.0f * y1;
+    m_by = 3.0f * (y2 - y1) - m_cy;
+    m_ay = 1.0f - m_cy - m_by;
+    m_linear = (x1 == y1) && (x2 == y2);
+
+    float constexpr step = 1.0f / static_cast<float>(sample_count - 1);
+    for (uint32_t i{0}; i < sample_count; ++i) {
+        m_samples[i] = getX(static_cast<float>(i) * step);
+    }
+}
+
+CubicBezier::CubicBezier(CubicBezier const& other)
+{
+    copyCurve(other);
+}
+
+CubicBezier& CubicBezier::operator=(CubicBezier const& other)
+{
+    // The registry keeps pointing to this object, which now describes the other curve
+    copyCurve(other);
+    return *this;
+}
+
+CubicBezier::~CubicBezier()
+{
+    if (uint32_t const handle = m_handle.load(std::memory_order_relaxed)) {
+        uint32_t const slot = handle & (max_registered - 1);
+        // Invalidate the handles before the slot can be reused
+        s_generations[slot].fetch_add(1, std::memory_order_release);
+        s_registry[slot].store(nullptr, std::memory_order_release);
+    }
+}
+
+void CubicBezier::copyCurve(CubicBezier const& other)
+{
+    m_ax = other.m_ax;
+    m_bx = other.m_bx;
+    m_cx = other.m_cx;
+    m_ay = other.m_ay;
+    m_by = other.m_by;
+    m_cy = other.m_cy;
+    m_linear = other.m_linear;
+    std::copy(other.m_samples, other.m_samples + sample_count, m_samples);
+}
+
+uint32_t CubicBezier::getHandle() const
+{
+    uint32_t handle = m_handle.load(std::memory_order_acquire);
+    if (handle) {
+        return handle;
+    }
+    for (uint32_t slot{1}; slot < max_registered; ++slot) {
+        CubicBezier const* free_slot{nullptr};
+        if (!s_registry[slot].compare_exchange_strong(free_slot, this, std::memory_order_acq_rel)) {
+            continue;
+        }
+        uint32_t const new_handle = slot | (getGeneration(slot) << slot_bits);
+        if (m_handle.compare_exchange_strong(handle, new_handle, std::memory_order_acq_rel)) {
+            return new_handle;
+        }
+        // Another thread registered this curve meanwhile, the new handle was never handed out
+        s_registry[slot].store(nullptr, std::memory_order_release);
+        return handle;
+    }
+    assert(false && "Too many CubicBezier registered, increase CubicBezier::max_registered");
+    return 0;
+}
+
+float CubicBezier::sample(float t) const
+{
+    if (m_linear) {
+        return t;
+    }
+    // Exact bounds
+    if (t <= 0.0f) {
+        return 0.0f;
+    }
+    if (t >= 1.0f) {
+        return 1.0f;
+    }
+    return getY(getParameter(t));
+}
+
+float CubicBezier::getParameter(float x) const
+{
+    float constexpr step = 1.0f / static_cast<float>(sample_count - 1);
+    // Find the sample interval containing x
+    uint32_t interval{0};
+    while (interval < sample_count - 2 && m_samples[interval + 1] <= x) {
+        ++interval;
+    }
+    float const interval_start = static_cast<float>(interval) * step;
+    // First guess assuming x is linear inside the interval
+    float const sample_delta = m_samples[interval + 1] - m_samples[interval];
+    float const dist = (sample_delta > 0.0f) ? (x - m_samples[interval]) / sample_delta : 0.0f;
+    float guess = interval_start + dist * step;
+
+    if (getSlopeX(guess) >= 1e-3f) {
+        // Newton-Raphson converges in a few iterations with a good first guess
+        for (uint32_t i{0}; i < 8; ++i) {
+            float const error = getX(guess) - x;
+            if (std::abs(error) < 1e-7f) {
+                return guess;
+            }
+            float const slope = getSlopeX(guess);
+            if (slope == 0.0f) {
+                break;
+            }
+            guess -= error / slope;
+        }
+        if (std::abs(getX(guess) - x) < 1e-6f) {
+            return guess;
+        }
+    }
+    // Flat regions make Newton unstable, fall back to bisection in the interval
+    float low = interval_start;
+    float high = interval_start + step;
+    for (uint32_t i{0}; i < 24; ++i) {
+        guess = 0.5f * (low + high);
+        float const error = getX(guess) - x;
+        if (std::abs(error) < 1e-7f) {
+            break;
+        }
+        (error > 0.0f) ? (high = guess) : (low = guess);
+    }
+    return guess;
+}
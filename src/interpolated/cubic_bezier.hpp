@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+
+/** A custom transition defined by the two control points of a cubic bezier curve,
+ *  with the same semantics as CSS cubic-bezier(x1, y1, x2, y2).
+ *  The curve parameter matching an input time is found in constant time: a table of
+ *  precomputed samples provides a first guess that is refined with Newton-Raphson iterations.
+ *  Values refer to curves through a process wide registry so that they store a 32 bits handle instead of a pointer.
+ */
+class CubicBezier
+{
+public:
+    /// The number of samples used to find the first guess
+    static constexpr uint32_t sample_count = 11;
+
+    /// The maximum number of curves registered at the same time
+    static constexpr uint32_t max_registered = 4096;
+    /// Handles store the registry slot in their low bits and the generation of the slot in the others
+    static constexpr uint32_t slot_bits = 12;
+    static_assert(max_registered == (1u << slot_bits));
+
+    /// Creates the curve, @p x1 and @p x2 are clamped to [0, 1] for the curve to be a function of time
+    CubicBezier(float x1, float y1, float x2, float y2);
+
+    /// Copies the curve, the copy has its own registration
+    CubicBezier(CubicBezier const& other);
+    CubicBezier& operator=(CubicBezier const& other);
+
+    /// Unregisters the curve, values still referring to it are evaluated as Linear even once the slot is reused
+    ~CubicBezier();
+
+    /// Returns the eased ratio at @p t
+    [[nodiscard]]
+    float sample(float t) const;
+
+    /** Returns the handle of this curve in the registry, the curve is registered on the first call.
+     *  Asserts and returns 0 if max_registered curves are already registered.
+     */
+    [[nodiscard]]
+    uint32_t getHandle() const;
+
+    /** Returns the curve designated by @p handle, nullptr for 0 or a destroyed curve.
+     *  The generation stored in the handle has to match the one of the slot, a slot reused by another curve
+     *  is only mistaken for the destroyed one after 2^20 reuses.
+     */
+    [[nodiscard]]
+    static CubicBezier const* get(uint32_t handle)
+    {
+        uint32_t const slot = handle & (max_registered - 1);
+        CubicBezier const* const curve = s_registry[slot].load(std::memory_order_acquire);
+        if (curve && getGeneration(slot) == (handle >> slot_bits)) {
+            return curve;
+        }
+        return nullptr;
+    }
+
+private:
+    /// The registered curves, slot 0 is never used
+    static inline std::atomic<CubicBezier const*> s_registry[max_registered]{};
+    /// Incremented when the curve of a slot is destroyed, so that handles to it become invalid
+    static inline std::atomic<uint32_t> s_generations[max_registered]{};
+
+    /// The handle of this curve in the registry, 0 until registered
+    mutable std::atomic<uint32_t> m_handle{0};
+
+    /// Returns the generation of @p slot truncated to the bits available in handles
+    [[nodiscard]]
+    static uint32_t getGeneration(uint32_t slot)
+    {
+        return s_generations[slot].load(std::memory_order_acquire) & ((1u << (32 - slot_bits)) - 1);
+    }
+
+    /// Polynomial coefficients of the x and y coordinates
+    float m_ax, m_bx, m_cx;
+    float m_ay, m_by, m_cy;
+    /// Set if the curve is the identity, no need to solve anything
+    bool m_linear;
+    /// The x coordinate of the curve for evenly spaced parameters
+    float m_samples[sample_count];
+
+    /// Copies the curve parameters, not the registration
+    void copyCurve(CubicBezier const& other);
+
+    [[nodiscard]]
+    float getX(float p) const
+    {
+        return ((m_ax * p + m_bx) * p + m_cx) * p;
+    }
+
+    [[nodiscard]]
+    float getY(float p) const
+    {
+        return ((m_ay * p + m_by) * p + m_cy) * p;
+    }
+
+    [[nodiscard]]
+    float getSlopeX(float p) const
+    {
+        return (3.0f * m_ax * p + 2.0f * m_bx) * p + m_cx;
+    }
+
+    /// Returns the curve parameter whose x coordinate is @p x
+    [[nodiscard]]
+    float getParameter(float x) const;
+};
@@ -1,13 +1,68 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
 
 /* ----- The transition functions -----
    The equations can be found on easings.net and in the GitHub repo
+   They are defined inline so that they can be inlined in callers when the transition is known at compile time
 */
-float linear(float t);
-float easeInOutExponential(float t);
-float easeOutBack(float t);
-float easeInBack(float t);
-float easeOutElastic(float t);
+constexpr float simplePow(float x, uint32_t p)
+{
+    float res = 1.0f;
+    for (uint32_t i(p); i--;) {
+        res *= x;
+    }
+    return res;
+}
+
+constexpr float linear(float t)
+{
+    return t;
+}
+
+inline float easeInOutExponential(float t)
+{
+    if (t < 0.5f) {
+        return std::pow(2.0f, 20.0f * t - 10.0f) * 0.5f;
+    }
+    return (2.0f - std::pow(2.0f, -20.0f * t + 10.0f)) * 0.5f;
+}
+
+constexpr float easeOutBack(float t)
+{
+    constexpr float c1 = 1.70158f;
+    constexpr float c3 = c1 + 1.0f;
+    return 1.0f + c3 * simplePow(t - 1.0f, 3) + c1 * simplePow(t - 1.0f, 2);
+}
+
+constexpr float easeInOutQuint(float t)
+{
+    if (t < 0.5f) {
+        return  16.0f * simplePow(t, 5);
+    }
+    return 1.0f - simplePow(-2.0f * t + 2, 5) * 0.5f;
+}
+
+constexpr float easeInBack(float t)
+{
+    float constexpr c1 = 1.70158f;
+    float constexpr c3 = c1 + 1.0f;
+    return c3 * t * t * t - c1 * t * t;
+}
+
+inline float easeOutElastic(float t)
+{
+    float constexpr two_pi = 2.0f * 3.14159265359f;
+    float constexpr c4 = two_pi / 3.0f;
+    if (t == 0.0f) {
+        return 0.0f;
+    }
+    if (t == 1.0f) {
+        return 1.0f;
+    }
+    return std::pow(2.0f, -10.0f * t) * std::sin((t * 10.0f - 0.75f) * c4) + 1.0f;
+}
 
 /// The currently supported transition functions
 enum class TransitionFunction
@@ -18,10 +73,94 @@ enum class TransitionFunction
     EaseOutBack,
     EaseInBack,
     EaseOutElastic,
+    /// Custom curve, the control points are provided by a CubicBezier object. Evaluated as Linear without it
+    CubicBezier,
 };
 
-/// Calls the easing function associated with the provided enum entry
-float getRatio(float t, TransitionFunction transition);
+/// Calls the easing function associated with the provided enum entry, ignoring tables
+inline float getAnalyticRatio(float t, TransitionFunction transition)
+{
+    switch (transition) {
+        default:
+            return t;
+        case TransitionFunction::None:
+            return 1.0f;
+        case TransitionFunction::Linear:
+            return t;
+        case TransitionFunction::EaseInOutExponential:
+            return easeInOutExponential(t);
+        case TransitionFunction::EaseOutBack:
+            return easeOutBack(t);
+        case TransitionFunction::EaseInBack:
+            return easeInBack(t);
+        case TransitionFunction::EaseOutElastic:
+            return easeOutElastic(t);
+    }
+}
+
+/// Transition tables state read by getRatio, see setTransitionTable
+struct TransitionTables
+{
+    /// Set while at least one table is registered, getRatio stays on the analytic path otherwise
+    static inline bool s_enabled{false};
+};
+
+/// Samples the table set for @p transition, or calls its easing function if it has none
+float getTableRatio(float t, TransitionFunction transition);
+
+/// Calls the easing function associated with the provided enum entry, or samples its table if one is set
+inline float getRatio(float t, TransitionFunction transition)
+{
+    if (TransitionTables::s_enabled) {
+        return getTableRatio(t, transition);
+    }
+    return getAnalyticRatio(t, transition);
+}
+
+/// Calls the easing function associated with @p TTransition, resolved at compile time and ignoring tables
+template<TransitionFunction TTransition>
+constexpr float getRatio(float t)
+{
+    if constexpr (TTransition == TransitionFunction::None) {
+        return 1.0f;
+    } else if constexpr (TTransition == TransitionFunction::EaseInOutExponential) {
+        return easeInOutExponential(t);
+    } else if constexpr (TTransition == TransitionFunction::EaseOutBack) {
+        return easeOutBack(t);
+    } else if constexpr (TTransition == TransitionFunction::EaseInBack) {
+        return easeInBack(t);
+    } else if constexpr (TTransition == TransitionFunction::EaseOutElastic) {
+        return easeOutElastic(t);
+    } else {
+        return linear(t);
+    }
+}
+
+/// The instruction sets available for batch evaluation
+enum class SimdLevel
+{
+    Scalar,
+    Sse,
+    Avx2,
+    Avx512,
+};
+
+/** Computes getRatio on @p count values at once using the widest instruction set supported by the CPU.
+ *  Transitions with a table sample it, like getRatio, so both always agree.
+ *  @p t and @p output can point to the same buffer.
+ */
+void getRatios(float const* t, float* output, size_t count, TransitionFunction transition);
+
+/** Computes start + (end - start) * ratio on @p count values at once, with the instruction set used by getRatios.
+ *  @p output can point to the same buffer as @p start or @p end.
+ */
+void lerpArrays(float const* start, float const* end, float ratio, float* output, size_t count);
+
+/// Returns the instruction set used by getRatios
+SimdLevel getSimdLevel();
+
+/// Restricts getRatios to @p level, or to the widest supported one if not available. Returns the selected level
+SimdLevel setSimdLevel(SimdLevel level);
 
 
 
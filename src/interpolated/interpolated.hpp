@@ -1,24 +1,87 @@
 #pragma once
-#include <chrono>
+#include <atomic>
+#include "clock.hpp"
+#include "cubic_bezier.hpp"
 #include "functions.hpp"
+#include "lerp.hpp"
+#include "transition_counter.hpp"
+
+
+/// Transition policy selecting the transition function at runtime
+struct DynamicTransition
+{
+    /// The transition function to use
+    TransitionFunction transition{TransitionFunction::Linear};
+    /// The registry handle of the curve used by TransitionFunction::CubicBezier, see CubicBezier::getHandle
+    uint32_t curve_handle{0};
+
+    /// Uses @p transition_function as transition
+    void setTransition(TransitionFunction transition_function)
+    {
+        transition = transition_function;
+        curve_handle = 0;
+    }
+
+    /// Uses @p bezier as transition, it has to outlive this object
+    void setTransition(CubicBezier const& bezier)
+    {
+        transition = TransitionFunction::CubicBezier;
+        curve_handle = bezier.getHandle();
+    }
+
+    /// A temporary curve would be unregistered at the end of the call
+    void setTransition(CubicBezier&&) = delete;
+
+    /// Returns the eased ratio at @p t
+    [[nodiscard]]
+    float getTransitionRatio(float t) const
+    {
+        if (transition == TransitionFunction::CubicBezier) {
+            if (CubicBezier const* const curve = CubicBezier::get(curve_handle)) {
+                return curve->sample(t);
+            }
+        }
+        return getRatio(t, transition);
+    }
+};
+
+/// Transition policy fixing the transition function at compile time, the easing is inlined in the caller
+template<TransitionFunction TTransition>
+struct StaticTransition
+{
+    /// The transition function to use
+    static constexpr TransitionFunction transition{TTransition};
+
+    /// Returns the eased ratio at @p t
+    [[nodiscard]]
+    static constexpr float getTransitionRatio(float t)
+    {
+        return getRatio<TTransition>(t);
+    }
+};
 
 
 /** An object that implements automatic interpolation on value changes.
  *  It can be used as a drop in replacement thanks to cast and assign operators.
+ *  The time source is provided by @p TClock, use @p FrameClock to read a timestamp sampled once per frame.
+ *  The transition function is provided by @p TTransition, see @p StaticInterpolated for a compile time one.
+ *  Once a read observes the end of a transition the value is settled, subsequent reads return
+ *  the target without querying the clock until a new value is set.
  */
-template<typename T>
-struct Interpolated
+template<typename T, typename TClock = SteadyClock, typename TTransition = DynamicTransition>
+struct Interpolated : public TTransition
 {
+    /// The interpolated type
+    using ValueType = T;
+
     /// The value at the start of the transition
     T start{};
     /// The target value
     T end{};
     /// The transition start timestamp
-    float start_time{};
-    /// The animation's speed
-    float speed{1.0f};
-    /// The transition function to use
-    TransitionFunction transition{TransitionFunction::Linear};
+    Tick start_time{};
+    /// The inverse of the transition duration in ticks, progress is elapsed ticks times this value
+    float inv_duration{1.0f / static_cast<float>(ticks_per_second)};
 
     /// Initializes the value with @p initial_value
     explicit
@@ -27,54 +90,109 @@ struct Interpolated
         , end{start}
     {}
 
-    /// Returns stop watch time (should be better compared to UTC timestamps for float precision)
+    Interpolated(Interpolated const& other)
+        : TTransition{other}
+        , start{other.start}
+        , end{other.end}
+        , start_time{other.start_time}
+        , inv_duration{other.inv_duration}
+    {
+        setInTransition(other.isInTransition());
+    }
+
+    Interpolated& operator=(Interpolated const& other)
+    {
+        TTransition::operator=(other);
+        start = other.start;
+        end = other.end;
+        start_time = other.start_time;
+        inv_duration = other.inv_duration;
+        setInTransition(other.isInTransition());
+        return *this;
+    }
+
+    ~Interpolated()
+    {
+        setInTransition(false);
+    }
+
+    /// Returns the current time provided by the clock policy
+    [[nodiscard]]
+    static Tick getCurrentTime()
+    {
+        return TClock::getTime();
+    }
+
+    /// Returns the number of ticks since the last value change
     [[nodiscard]]
-    static float getCurrentTime()
+    Tick getElapsedTicks() const
     {
-        // Retrieve current time
-        auto const now = std::chrono::steady_clock::now();
-        auto const duration = now.time_since_epoch();
-        // Convert it to a decimal number of seconds
-        auto const seconds = std::chrono::duration_cast<std::chrono::duration<float>>(duration);
-        return seconds.count();
+        return getCurrentTime() - start_time;
     }
 
     /// Returns the number of seconds since the last value change
     [[nodiscard]]
     float getElapsedSeconds() const
     {
-        return getCurrentTime() - start_time;
+        return toSeconds(getElapsedTicks());
     }
 
     /// Sets a new target value and resets transition
     void setValue(T const& new_value)
     {
-        start = getValue();
+        // The current value is written in place, heavy types reuse the storage of start
+        getValue(start);
         end = new_value;
         start_time = getCurrentTime();
+        setInTransition(true);
+        TransitionCounter::addEndTime(getEndTime());
     }
 
     /// Returns the current value
     [[nodiscard]]
     T getValue() const
     {
-        // Current transition time
-        float const elapsed = getElapsedSeconds();
-        float const t = elapsed * speed;
-        // Check if the transition is over
-        if (t >= 1.0f) {
-            // If the transition is done, directly return the target value
+        float ratio{0.0f};
+        if (!getCurrentRatio(ratio)) {
             return end;
         }
-        // Else compute interpolated value and return it
-        T const delta{end - start};
-        return start + delta * getRatio(t, transition);
+        T value{};
+        lerpInto(value, start, end, ratio);
+        return value;
     }
 
-    /// Computes the speed given a duration
+    /** Writes the current value in @p output.
+     *  Types with a lerpInto overload, like std::vector, reuse the storage of @p output instead of allocating.
+     */
+    void getValue(T& output) const
+    {
+        float ratio{0.0f};
+        if (getCurrentRatio(ratio)) {
+            lerpInto(output, start, end, ratio);
+        } else {
+            output = end;
+        }
+    }
+
+    /// Sets the transition duration in seconds
     void setDuration(float duration)
     {
-        speed = 1.0f / duration;
+        inv_duration = toInvDuration(duration);
+        onDurationChanged();
+    }
+
+    /// Sets the transition speed, the number of transitions per second
+    void setSpeed(float speed)
+    {
+        inv_duration = speed / static_cast<float>(ticks_per_second);
+        onDurationChanged();
+    }
+
+    /// Returns the timestamp at which the current transition ends
+    [[nodiscard]]
+    Tick getEndTime() const
+    {
+        return start_time + static_cast<Tick>(std::ceil(1.0 / static_cast<double>(inv_duration)));
     }
 
     /// Cast operator to use this object directly as if it was of type T
@@ -89,4 +207,72 @@ struct Interpolated
     {
         setValue(new_value);
     }
+
+    /** Returns true if the value may have changed after @p time, for instance the timestamp of the last render.
+     *  Renderers can skip rebuilding what depends on values that did not change since their last update.
+     *  Only changes made through setValue are tracked, not direct writes to the fields.
+     */
+    [[nodiscard]]
+    bool hasChangedSince(Tick time) const
+    {
+        // The transition was not over at time, the value moved since
+        return static_cast<float>(time - start_time) * inv_duration <= 1.0f;
+    }
+
+    /// Returns true until a read observed the end of the current transition
+    [[nodiscard]]
+    bool isInTransition() const
+    {
+        return m_in_transition.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// Set while a transition is running, atomic so that concurrent reads settle only once
+    mutable std::atomic<bool> m_in_transition{false};
+
+    /// Updates the transition state and the global counter
+    void setInTransition(bool in_transition)
+    {
+        if (m_in_transition.exchange(in_transition, std::memory_order_relaxed) != in_transition) {
+            in_transition ? TransitionCounter::add() : TransitionCounter::remove();
+        }
+    }
+
+    /// A running transition can end later
+    void onDurationChanged()
+    {
+        if (isInTransition()) {
+            TransitionCounter::addEndTime(getEndTime());
+        }
+    }
+
+    /// Returns false if the value reached its target, else writes the eased transition ratio in @p ratio
+    bool getCurrentRatio(float& ratio) const
+    {
+        // Settled values do not need to check the time
+        if (!isInTransition()) {
+            return false;
+        }
+        // Current transition time, the integer difference is exact whatever the uptime
+        float const t = static_cast<float>(getElapsedTicks()) * inv_duration;
+        // Check if the transition is over, NaN for zero durations
+        if (!(t < 1.0f)) {
+            settle();
+            return false;
+        }
+        ratio = TTransition::getTransitionRatio(t);
+        return true;
+    }
+
+    /// Marks the transition as over
+    void settle() const
+    {
+        if (m_in_transition.exchange(false, std::memory_order_relaxed)) {
+            TransitionCounter::remove();
+        }
+    }
 };
+
+/// Interpolated value with a transition function fixed at compile time
+template<typename T, TransitionFunction TTransition, typename TClock = SteadyClock>
+using StaticInterpolated = Interpolated<T, TClock, StaticTransition<TTransition>>;
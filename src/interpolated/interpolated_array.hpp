@@ -0,0 +1,256 @@
+#pragma once
+#include <array>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+#include "clock.hpp"
+#include "cubic_bezier.hpp"
+#include "functions.hpp"
+
+
+/** A collection of interpolated values stored as a structure of arrays.
+ *  Each field of @p Interpolated has its own contiguous column so that all the values
+ *  can be evaluated at once in tight, auto-vectorizable loops using @p evaluate.
+ *  Per index semantics are the same as @p Interpolated.
+ */
+template<typename T, typename TClock = SteadyClock>
+class InterpolatedArray
+{
+public:
+    /// The interpolated type
+    using ValueType = T;
+    /// The time source
+    using Clock = TClock;
+
+    /// The number of elements processed per evaluation step, scratch buffers live on the stack
+    static constexpr uint32_t chunk_size = 256;
+
+    InterpolatedArray() = default;
+
+    /// Creates @p count values initialized with @p initial_value
+    explicit
+    InterpolatedArray(size_t count, T const& initial_value = {})
+    {
+        resize(count, initial_value);
+    }
+
+    /// Adds a new value and returns its index
+    size_t add(T const& initial_value = {})
+    {
+        m_start.push_back(initial_value);
+        m_end.push_back(initial_value);
+        m_start_time.push_back(0);
+        m_inv_duration.push_back(1.0f / static_cast<float>(ticks_per_second));
+        m_transition.push_back(TransitionFunction::Linear);
+        m_curve.push_back(0);
+        return m_start.size() - 1;
+    }
+
+    /// Sets the number of values, new ones are initialized with @p initial_value
+    void resize(size_t count, T const& initial_value = {})
+    {
+        m_start.resize(count, initial_value);
+        m_end.resize(count, initial_value);
+        m_start_time.resize(count, 0);
+        m_inv_duration.resize(count, 1.0f / static_cast<float>(ticks_per_second));
+        m_transition.resize(count, TransitionFunction::Linear);
+        m_curve.resize(count, 0);
+    }
+
+    /// Returns the number of values
+    [[nodiscard]]
+    size_t size() const
+    {
+        return m_start.size();
+    }
+
+    /// Sets a new target value for the value at @p index and resets its transition
+    void setValue(size_t index, T const& new_value)
+    {
+        Tick const now = TClock::getTime();
+        m_start[index] = getValue(index, now);
+        m_end[index] = new_value;
+        m_start_time[index] = now;
+    }
+
+    /// Sets the transition duration in seconds of the value at @p index
+    void setDuration(size_t index, float duration)
+    {
+        m_inv_duration[index] = toInvDuration(duration);
+    }
+
+    /// Sets the transition function of the value at @p index
+    void setTransition(size_t index, TransitionFunction transition)
+    {
+        m_transition[index] = transition;
+        m_curve[index] = 0;
+    }
+
+    /// Uses @p bezier as transition of the value at @p index, it has to outlive this object
+    void setTransition(size_t index, CubicBezier const& bezier)
+    {
+        m_transition[index] = TransitionFunction::CubicBezier;
+        m_curve[index] = bezier.getHandle();
+    }
+
+    /// A temporary curve would be unregistered at the end of the call
+    void setTransition(size_t, CubicBezier&&) = delete;
+
+    /// Returns the transition function of the value at @p index
+    [[nodiscard]]
+    TransitionFunction getTransition(size_t index) const
+    {
+        return m_transition[index];
+    }
+
+    /// Returns the target value at @p index
+    [[nodiscard]]
+    T const& getTarget(size_t index) const
+    {
+        return m_end[index];
+    }
+
+    /// Returns the current value at @p index
+    [[nodiscard]]
+    T getValue(size_t index) const
+    {
+        return getValue(index, TClock::getTime());
+    }
+
+    /** Writes the current value of every element in @p output.
+     *  @p output has to point to at least @p size elements.
+     *  The clock is read only once for the whole evaluation.
+     */
+    void evaluate(T* output) const
+    {
+        evaluate(0, size(), TClock::getTime(), output);
+    }
+
+    /// Writes the value at time @p now of the @p count elements starting at @p first in @p output
+    void evaluate(size_t first, size_t count, Tick now, T* output) const
+    {
+        size_t const last = first + count;
+        for (size_t chunk_start{first}; chunk_start < last; chunk_start += chunk_size) {
+            auto const chunk_count = static_cast<uint32_t>(std::min<size_t>(chunk_size, last - chunk_start));
+            evaluateChunk(chunk_start, chunk_count, now, output + (chunk_start - first));
+        }
+    }
+
+    /// Writes the current value of every element in @p output, resizing it if needed
+    void evaluate(std::vector<T>& output) const
+    {
+        output.resize(size());
+        evaluate(output.data());
+    }
+
+private:
+    /// The values at the start of the transitions
+    std::vector<T> m_start;
+    /// The target values
+    std::vector<T> m_end;
+    /// The transitions start timestamps
+    std::vector<Tick> m_start_time;
+    /// The inverse of the transitions durations in ticks
+    std::vector<float> m_inv_duration;
+    /// The transition functions to use
+    std::vector<TransitionFunction> m_transition;
+    /// The registry handles of the curves used by TransitionFunction::CubicBezier, see CubicBezier::getHandle
+    std::vector<uint32_t> m_curve;
+
+    /// Returns the value at @p index at time @p now
+    [[nodiscard]]
+    T getValue(size_t index, Tick now) const
+    {
+        float const t = static_cast<float>(now - m_start_time[index]) * m_inv_duration[index];
+        if (!(t < 1.0f)) {
+            return m_end[index];
+        }
+        T const delta{m_end[index] - m_start[index]};
+        return m_start[index] + delta * getTransitionRatio(index, t);
+    }
+
+    /// Returns the eased ratio of the value at @p index
+    [[nodiscard]]
+    float getTransitionRatio(size_t index, float t) const
+    {
+        if (m_transition[index] == TransitionFunction::CubicBezier) {
+            if (CubicBezier const* const curve = CubicBezier::get(m_curve[index])) {
+                return curve->sample(t);
+            }
+        }
+        return getRatio(t, m_transition[index]);
+    }
+
+    /** Evaluates @p count elements starting at @p first.
+     *  Each step is a separate loop over the chunk so that the branch free ones can be vectorized.
+     */
+    void evaluateChunk(size_t first, uint32_t count, Tick now, T* output) const
+    {
+        float progress[chunk_size];
+        float ratios[chunk_size];
+        // Compute transitions progress, std::min also turns the NaN of zero durations into 1
+        Tick const* start_time = m_start_time.data() + first;
+        float const* inv_duration = m_inv_duration.data() + first;
+        for (uint32_t i{0}; i < count; ++i) {
+            progress[i] = std::min(1.0f, static_cast<float>(now - start_time[i]) * inv_duration[i]);
+        }
+        // Apply easing, runs sharing the same transition are evaluated in a single batch
+        TransitionFunction const* transition = m_transition.data() + first;
+        uint32_t const* curve = m_curve.data() + first;
+        uint32_t run_start{0};
+        while (run_start < count) {
+            uint32_t run_end{run_start + 1};
+            while (run_end < count && transition[run_end] == transition[run_start] && curve[run_end] == curve[run_start]) {
+                ++run_end;
+            }
+            CubicBezier const* const bezier = (transition[run_start] == TransitionFunction::CubicBezier) ? CubicBezier::get(curve[run_start]) : nullptr;
+            if (bezier) {
+                for (uint32_t i{run_start}; i < run_end; ++i) {
+                    ratios[i] = bezier->sample(progress[i]);
+                }
+            } else {
+                getRatios(progress + run_start, ratios + run_start, run_end - run_start, transition[run_start]);
+            }
+            run_start = run_end;
+        }
+        // Interpolate values, finished transitions directly use the target
+        T const* start = m_start.data() + first;
+        T const* end = m_end.data() + first;
+        for (uint32_t i{0}; i < count; ++i) {
+            float const ratio = (progress[i] < 1.0f) ? ratios[i] : 1.0f;
+            output[i] = start[i] + (end[i] - start[i]) * ratio;
+        }
+    }
+};
+
+
+/** Evaluates several arrays in a single pass and hands the values of each index to @p layout,
+ *  which writes them in @p stride consecutive elements of @p output, for instance the vertices of a quad.
+ *  Values go through small stack buffers, there is no intermediate copy of the whole arrays nor shape objects.
+ *  @p layout is called as layout(output + index * stride, value_0, value_1, ...) for each index,
+ *  only the elements present in all the arrays are evaluated.
+ */
+template<typename TOutput, typename TLayout, typename... TArrays>
+void evaluateInto(TOutput* output, uint32_t stride, TLayout&& layout, TArrays const&... arrays)
+{
+    static_assert(sizeof...(TArrays) > 0, "At least one array is required");
+    constexpr uint32_t chunk_size = std::min({TArrays::chunk_size...});
+    size_t const count = std::min({arrays.size()...});
+    // Each array reads its own clock once
+    Tick const times[]{TArrays::Clock::getTime()...};
+    std::tuple<std::array<typename TArrays::ValueType, chunk_size>...> buffers;
+    for (size_t chunk_start{0}; chunk_start < count; chunk_start += chunk_size) {
+        auto const chunk_count = static_cast<uint32_t>(std::min<size_t>(chunk_size, count - chunk_start));
+        std::apply([&](auto&... buffer) {
+            size_t array_index{0};
+            (arrays.evaluate(chunk_start, chunk_count, times[array_index++], buffer.data()), ...);
+            TOutput* chunk_output = output + chunk_start * stride;
+            for (uint32_t i{0}; i < chunk_count; ++i) {
+                layout(chunk_output + i * stride, std::as_const(buffer[i])...);
+            }
+        }, buffers);
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "clock.hpp"
+#include "functions.hpp"
+#include "interpolated.hpp"
+
+
+/** A buffer of floats sharing a single transition, to morph meshes or curves as a whole.
+ *  The easing is computed once per evaluation and applied to all the values with a vectorized lerp,
+ *  large buffers can be split across a thread pool.
+ *  Compared to one Interpolated<float> per value it only stores the start and target arrays.
+ */
+template<typename TClock = SteadyClock, typename TTransition = DynamicTransition>
+class InterpolatedBuffer : public TTransition
+{
+public:
+    /// Below this number of values, evaluations with a thread pool stay on the calling thread
+    static constexpr size_t parallel_threshold = 1 << 16;
+
+    InterpolatedBuffer() = default;
+
+    /// Creates a buffer of @p count values initialized with @p initial_value
+    explicit
+    InterpolatedBuffer(size_t count, float initial_value = 0.0f)
+        : m_start(count, initial_value)
+        , m_end(count, initial_value)
+    {}
+
+    /// Creates a buffer initialized with @p initial_values
+    explicit
+    InterpolatedBuffer(std::vector<float> const& initial_values)
+        : m_start{initial_values}
+        , m_end{initial_values}
+    {}
+
+    /// Returns the number of values
+    [[nodiscard]]
+    size_t size() const
+    {
+        return m_end.size();
+    }
+
+    /** Sets new target values and resets the transition, the current values become the start.
+     *  If the size changes, values added at the end directly take their target.
+     */
+    void setValues(std::vector<float> const& new_values)
+    {
+        // The current values are written in place
+        float const ratio = getRatio();
+        size_t const common = std::min(size(), new_values.size());
+        lerpArrays(m_start.data(), m_end.data(), ratio, m_start.data(), common);
+        m_start.resize(new_values.size());
+        std::copy(new_values.begin() + common, new_values.end(), m_start.begin() + common);
+        m_end = new_values;
+        m_start_time = TClock::getTime();
+    }
+
+    /// Sets the transition duration in seconds
+    void setDuration(float duration)
+    {
+        m_inv_duration = toInvDuration(duration);
+    }
+
+    /// Sets the transition speed, the number of transitions per second
+    void setSpeed(float speed)
+    {
+        m_inv_duration = speed / static_cast<float>(ticks_per_second);
+    }
+
+    /// Returns the target values
+    [[nodiscard]]
+    std::vector<float> const& getTarget() const
+    {
+        return m_end;
+    }
+
+    /// Returns the eased transition ratio, 1 once the transition is over
+    [[nodiscard]]
+    float getRatio() const
+    {
+        float const t = static_cast<float>(TClock::getTime() - m_start_time) * m_inv_duration;
+        if (!(t < 1.0f)) {
+            return 1.0f;
+        }
+        return TTransition::getTransitionRatio(t);
+    }
+
+    /// Writes the current values in @p output, it has to point to at least @p size floats
+    void evaluate(float* output) const
+    {
+        evaluateRange(0, size(), getRatio(), output);
+    }
+
+    /// Writes the current values in @p output, resizing it if needed
+    void evaluate(std::vector<float>& output) const
+    {
+        output.resize(size());
+        evaluate(output.data());
+    }
+
+    /** Writes the current values in @p output, large buffers are split across @p pool.
+     *  @p pool has to provide dispatch(count, callback(start, end)) returning once all the ranges are done, like pez::ThreadPool.
+     */
+    template<typename TPool>
+    void evaluate(float* output, TPool& pool) const
+    {
+        float const ratio = getRatio();
+        if (size() < parallel_threshold) {
+            evaluateRange(0, size(), ratio, output);
+            return;
+        }
+        pool.dispatch(size(), [this, ratio, output](size_t start, size_t end) {
+            evaluateRange(start, end - start, ratio, output + start);
+        });
+    }
+
+private:
+    /// The values at the start of the transition
+    std::vector<float> m_start;
+    /// The target values
+    std::vector<float> m_end;
+    /// The transition start timestamp
+    Tick m_start_time{};
+    /// The inverse of the transition duration in ticks
+    float m_inv_duration{1.0f / static_cast<float>(ticks_per_second)};
+
+    /// Writes the @p count values starting at @p first with the eased @p ratio
+    void evaluateRange(size_t first, size_t count, float ratio, float* output) const
+    {
+        if (ratio == 1.0f) {
+            std::copy(m_end.begin() + first, m_end.begin() + first + count, output);
+            return;
+        }
+        lerpArrays(m_start.data() + first, m_end.data() + first, ratio, output, count);
+    }
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+
+#include "clock.hpp"
+#include "functions.hpp"
+
+
+/** A multi segment curve going through a list of keyframes.
+ *  Each segment has its own duration and transition function, all the data is stored in contiguous arrays.
+ *  @p sample performs a binary search for random seeks while @p getValue follows the clock
+ *  with a cached cursor, which is constant time when time is increasing.
+ */
+template<typename T, typename TClock = SteadyClock>
+class KeyframeTrack
+{
+public:
+    /// Creates a track starting at @p initial_value
+    explicit
+    KeyframeTrack(T const& initial_value = {})
+    {
+        m_times.push_back(0.0f);
+        m_values.push_back(initial_value);
+    }
+
+    /// Appends a segment reaching @p value after @p duration seconds using @p transition
+    void addSegment(T const& value, float duration, TransitionFunction transition = TransitionFunction::Linear)
+    {
+        duration = std::max(duration, 0.0f);
+        m_times.push_back(m_times.back() + duration);
+        m_values.push_back(value);
+        m_inv_durations.push_back(duration > 0.0f ? 1.0f / duration : 0.0f);
+        m_transitions.push_back(transition);
+    }
+
+    /// Removes all segments, keeping the initial value
+    void clear()
+    {
+        m_times.resize(1);
+        m_values.resize(1);
+        m_inv_durations.clear();
+        m_transitions.clear();
+        m_cursor = 0;
+    }
+
+    /// Returns the number of segments
+    [[nodiscard]]
+    size_t getSegmentCount() const
+    {
+        return m_transitions.size();
+    }
+
+    /// Returns the total duration of the track in seconds
+    [[nodiscard]]
+    float getDuration() const
+    {
+        return m_times.back();
+    }
+
+    /// Returns the value at @p time seconds from the start of the track, finding the segment with a binary search
+    [[nodiscard]]
+    T sample(float time) const
+    {
+        if (time <= 0.0f || getSegmentCount() == 0) {
+            return m_values.front();
+        }
+        if (time >= getDuration()) {
+            return m_values.back();
+        }
+        // Last keyframe at or before time, zero length segments are skipped
+        auto const it = std::upper_bound(m_times.begin(), m_times.end(), time);
+        auto const segment = static_cast<size_t>(it - m_times.begin()) - 1;
+        return sampleSegment(segment, time);
+    }
+
+    /// Returns the value at @p time seconds, starting from the segment found by the previous call
+    [[nodiscard]]
+    T sampleForward(float time) const
+    {
+        if (time <= 0.0f || getSegmentCount() == 0) {
+            return m_values.front();
+        }
+        if (time >= getDuration()) {
+            m_cursor = getSegmentCount() - 1;
+            return m_values.back();
+        }
+        if (time < m_times[m_cursor]) {
+            // Going backward, restart from a binary search
+            auto const it = std::upper_bound(m_times.begin(), m_times.end(), time);
+            m_cursor = static_cast<size_t>(it - m_times.begin()) - 1;
+        } else {
+            while (time >= m_times[m_cursor + 1]) {
+                ++m_cursor;
+            }
+        }
+        return sampleSegment(m_cursor, time);
+    }
+
+    /// Starts playing the track from its beginning
+    void start()
+    {
+        m_start_time = TClock::getTime();
+        m_cursor = 0;
+    }
+
+    /// Returns the value at the current time since the last call to @p start
+    [[nodiscard]]
+    T getValue() const
+    {
+        return sampleForward(toSeconds(TClock::getTime() - m_start_time));
+    }
+
+    /// Cast operator to use this object directly as if it was of type T
+    [[nodiscard]]
+    operator T() const
+    {
+        return getValue();
+    }
+
+private:
+    /// The time of each keyframe in seconds, the first one is 0
+    std::vector<float> m_times;
+    /// The value of each keyframe
+    std::vector<T> m_values;
+    /// The inverse duration of each segment
+    std::vector<float> m_inv_durations;
+    /// The transition function of each segment
+    std::vector<TransitionFunction> m_transitions;
+    /// The segment found by the last forward sample
+    mutable size_t m_cursor = 0;
+    /// The timestamp of the last call to start
+    Tick m_start_time{};
+
+    /// Returns the value at @p time in @p segment, @p time has to be inside the segment
+    [[nodiscard]]
+    T sampleSegment(size_t segment, float time) const
+    {
+        float const t = (time - m_times[segment]) * m_inv_durations[segment];
+        T const& segment_start = m_values[segment];
+        T const delta{m_values[segment + 1] - segment_start};
+        return segment_start + delta * getRatio(t, m_transitions[segment]);
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+
+
+/** Customization point writing the interpolation between @p start and @p end at @p ratio in @p output.
+ *  The default uses the arithmetic operators of @p T, which creates temporaries.
+ *  Types that allocate can overload lerpInto in their own namespace to reuse the storage of @p output.
+ *  @p output may be the same object as @p start or @p end.
+ */
+template<typename T>
+void lerpInto(T& output, T const& start, T const& end, float ratio)
+{
+    output = start + (end - start) * ratio;
+}
+
+/** Element wise interpolation, @p output takes the size of @p end and only allocates if its capacity is too small.
+ *  Elements missing from @p start directly take the value of @p end.
+ */
+template<typename TElement>
+void lerpInto(std::vector<TElement>& output, std::vector<TElement> const& start, std::vector<TElement> const& end, float ratio)
+{
+    size_t const common = std::min(start.size(), end.size());
+    // Resizing keeps the first elements, output can be start
+    output.resize(end.size());
+    for (size_t i{0}; i < common; ++i) {
+        lerpInto(output[i], start[i], end[i], ratio);
+    }
+    for (size_t i{common}; i < end.size(); ++i) {
+        output[i] = end[i];
+    }
+}
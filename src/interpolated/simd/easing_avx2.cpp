@@ -0,0 +1,75 @@
+#include "easing_kernels.hpp"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+namespace
+{
+
+/// AVX2 + FMA wrapper, 8 floats per vector
+struct Avx2
+{
+    using Type = __m256;
+    static constexpr uint32_t width = 8;
+
+    static Type set(float v) { return _mm256_set1_ps(v); }
+    static Type load(float const* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+    static Type add(Type a, Type b) { return _mm256_add_ps(a, b); }
+    static Type sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+    static Type mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+    static Type fma(Type a, Type b, Type c) { return _mm256_fmadd_ps(a, b, c); }
+    static Type min(Type a, Type b) { return _mm256_min_ps(a, b); }
+    static Type max(Type a, Type b) { return _mm256_max_ps(a, b); }
+    static Type round(Type a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Type less(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Type equal(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    /// Returns @p a where @p mask is set, @p b elsewhere
+    static Type select(Type mask, Type a, Type b) { return _mm256_blendv_ps(b, a, mask); }
+
+    /// Returns 2^n for integral values of @p n
+    static Type pow2i(Type n)
+    {
+        __m256i const e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+    }
+
+    /// Returns a mask set where the integral value of @p n has @p bit set
+    static Type hasBit(Type n, int32_t bit)
+    {
+        __m256i const b = _mm256_set1_epi32(bit);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_cvtps_epi32(n), b), b));
+    }
+};
+
+}
+
+namespace simd
+{
+void getRatiosAvx2(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    getRatios<Avx2>(t, output, count, transition);
+}
+
+void lerpArraysAvx2(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    lerpArrays<Avx2>(start, end, ratio, output, count);
+}
+}
+
+#else
+
+namespace simd
+{
+void getRatiosAvx2(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    getRatiosSse(t, output, count, transition);
+}
+
+void lerpArraysAvx2(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    lerpArraysSse(start, end, ratio, output, count);
+}
+}
+
+#endif
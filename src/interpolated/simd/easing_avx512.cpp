@@ -0,0 +1,81 @@
+#include "easing_kernels.hpp"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+// GCC 12 AVX-512 intrinsics trigger false positive uninitialized warnings (GCC bug 105593)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace
+{
+
+/// AVX-512 wrapper, 16 floats per vector, comparisons produce bit masks
+struct Avx512
+{
+    using Type = __m512;
+    using Mask = __mmask16;
+    static constexpr uint32_t width = 16;
+
+    static Type set(float v) { return _mm512_set1_ps(v); }
+    static Type load(float const* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, Type v) { _mm512_storeu_ps(p, v); }
+    static Type add(Type a, Type b) { return _mm512_add_ps(a, b); }
+    static Type sub(Type a, Type b) { return _mm512_sub_ps(a, b); }
+    static Type mul(Type a, Type b) { return _mm512_mul_ps(a, b); }
+    static Type fma(Type a, Type b, Type c) { return _mm512_fmadd_ps(a, b, c); }
+    static Type min(Type a, Type b) { return _mm512_min_ps(a, b); }
+    static Type max(Type a, Type b) { return _mm512_max_ps(a, b); }
+    static Type round(Type a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Mask less(Type a, Type b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static Mask equal(Type a, Type b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    /// Returns @p a where @p mask is set, @p b elsewhere
+    static Type select(Mask mask, Type a, Type b) { return _mm512_mask_blend_ps(mask, b, a); }
+
+    /// Returns 2^n for integral values of @p n
+    static Type pow2i(Type n)
+    {
+        __m512i const e = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(e, 23));
+    }
+
+    /// Returns a mask set where the integral value of @p n has @p bit set
+    static Mask hasBit(Type n, int32_t bit)
+    {
+        return _mm512_test_epi32_mask(_mm512_cvtps_epi32(n), _mm512_set1_epi32(bit));
+    }
+};
+
+}
+
+namespace simd
+{
+void getRatiosAvx512(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    getRatios<Avx512>(t, output, count, transition);
+}
+
+void lerpArraysAvx512(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    lerpArrays<Avx512>(start, end, ratio, output, count);
+}
+}
+
+#else
+
+namespace simd
+{
+void getRatiosAvx512(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    getRatiosAvx2(t, output, count, transition);
+}
+
+void lerpArraysAvx512(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    lerpArraysAvx2(start, end, ratio, output, count);
+}
+}
+
+#endif
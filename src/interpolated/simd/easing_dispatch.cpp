@@ -0,0 +1,172 @@
+#include <algorithm>
+#include "easing_kernels.hpp"
+#include "../transition_table.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define INTERPOLATED_SIMD_X86
+/// Returns the widest instruction set supported by both the CPU and the OS
+SimdLevel detectSimdLevel()
+{
+    int info[4]{};
+    __cpuid(info, 1);
+    bool const sse41 = info[2] & (1 << 19);
+    bool const fma = info[2] & (1 << 12);
+    bool const os_xsave = info[2] & (1 << 27);
+    if (!sse41) {
+        return SimdLevel::Scalar;
+    }
+    if (!os_xsave) {
+        return SimdLevel::Sse;
+    }
+    // Check that the OS saves AVX (bits 1, 2) and AVX-512 (bits 5, 6, 7) registers
+    uint64_t const xcr0 = _xgetbv(0);
+    bool const os_avx = (xcr0 & 0x6) == 0x6;
+    bool const os_avx512 = (xcr0 & 0xE6) == 0xE6;
+    __cpuidex(info, 7, 0);
+    bool const avx2 = info[1] & (1 << 5);
+    bool const avx512f = info[1] & (1 << 16);
+    if (os_avx512 && avx512f) {
+        return SimdLevel::Avx512;
+    }
+    if (os_avx && avx2 && fma) {
+        return SimdLevel::Avx2;
+    }
+    return SimdLevel::Sse;
+}
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTERPOLATED_SIMD_X86
+/// Returns the widest instruction set supported by both the CPU and the OS
+SimdLevel detectSimdLevel()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdLevel::Sse;
+    }
+    return SimdLevel::Scalar;
+}
+#else
+SimdLevel detectSimdLevel()
+{
+    return SimdLevel::Scalar;
+}
+#endif
+
+using Kernel = void(*)(float const*, float*, size_t, TransitionFunction);
+using LerpKernel = void(*)(float const*, float const*, float, float*, size_t);
+
+Kernel getKernel(SimdLevel level)
+{
+    switch (level) {
+#if defined(INTERPOLATED_SIMD_X86)
+        case SimdLevel::Avx512:
+            return &simd::getRatiosAvx512;
+        case SimdLevel::Avx2:
+            return &simd::getRatiosAvx2;
+        case SimdLevel::Sse:
+            return &simd::getRatiosSse;
+#endif
+        default:
+            return &simd::getRatiosScalar;
+    }
+}
+
+LerpKernel getLerpKernel(SimdLevel level)
+{
+    switch (level) {
+#if defined(INTERPOLATED_SIMD_X86)
+        case SimdLevel::Avx512:
+            return &simd::lerpArraysAvx512;
+        case SimdLevel::Avx2:
+            return &simd::lerpArraysAvx2;
+        case SimdLevel::Sse:
+            return &simd::lerpArraysSse;
+#endif
+        default:
+            return &simd::lerpArraysScalar;
+    }
+}
+
+/// The selected instruction set and its kernels
+struct Dispatch
+{
+    /// The widest supported instruction set
+    SimdLevel supported_level = detectSimdLevel();
+    /// The instruction set currently in use
+    SimdLevel level = supported_level;
+    /// The kernels associated with level
+    Kernel kernel = getKernel(level);
+    LerpKernel lerp_kernel = getLerpKernel(level);
+};
+
+/// Detection is performed on first use to avoid depending on static initialization order
+Dispatch& getDispatch()
+{
+    static Dispatch dispatch;
+    return dispatch;
+}
+
+}
+
+namespace simd
+{
+void getRatiosScalar(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    for (size_t i{0}; i < count; ++i) {
+        output[i] = getAnalyticRatio(t[i], transition);
+    }
+}
+
+void lerpArraysScalar(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    for (size_t i{0}; i < count; ++i) {
+        output[i] = start[i] + (end[i] - start[i]) * ratio;
+    }
+}
+}
+
+void getRatios(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    if (TransitionTables::s_enabled) {
+        if (TransitionTable const* table = getTransitionTable(transition)) {
+            for (size_t i{0}; i < count; ++i) {
+                output[i] = table->sample(t[i]);
+            }
+            return;
+        }
+    }
+    getDispatch().kernel(t, output, count, transition);
+}
+
+void lerpArrays(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    getDispatch().lerp_kernel(start, end, ratio, output, count);
+}
+
+SimdLevel getSimdLevel()
+{
+    return getDispatch().level;
+}
+
+SimdLevel setSimdLevel(SimdLevel level)
+{
+    Dispatch& dispatch = getDispatch();
+    dispatch.level = std::min(level, dispatch.supported_level);
+    dispatch.kernel = getKernel(dispatch.level);
+    dispatch.lerp_kernel = getLerpKernel(dispatch.level);
+    return dispatch.level;
+}
@@ -0,0 +1,75 @@
+#include "easing_kernels.hpp"
+
+#if defined(__SSE4_1__) || defined(_M_X64)
+#include <smmintrin.h>
+
+namespace
+{
+
+/// SSE 4.1 wrapper, 4 floats per vector
+struct Sse
+{
+    using Type = __m128;
+    static constexpr uint32_t width = 4;
+
+    static Type set(float v) { return _mm_set1_ps(v); }
+    static Type load(float const* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Type v) { _mm_storeu_ps(p, v); }
+    static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+    static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+    static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+    static Type fma(Type a, Type b, Type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static Type min(Type a, Type b) { return _mm_min_ps(a, b); }
+    static Type max(Type a, Type b) { return _mm_max_ps(a, b); }
+    static Type round(Type a) { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Type less(Type a, Type b) { return _mm_cmplt_ps(a, b); }
+    static Type equal(Type a, Type b) { return _mm_cmpeq_ps(a, b); }
+    /// Returns @p a where @p mask is set, @p b elsewhere
+    static Type select(Type mask, Type a, Type b) { return _mm_blendv_ps(b, a, mask); }
+
+    /// Returns 2^n for integral values of @p n
+    static Type pow2i(Type n)
+    {
+        __m128i const e = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+        return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+    }
+
+    /// Returns a mask set where the integral value of @p n has @p bit set
+    static Type hasBit(Type n, int32_t bit)
+    {
+        __m128i const b = _mm_set1_epi32(bit);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_cvtps_epi32(n), b), b));
+    }
+};
+
+}
+
+namespace simd
+{
+void getRatiosSse(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    getRatios<Sse>(t, output, count, transition);
+}
+
+void lerpArraysSse(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    lerpArrays<Sse>(start, end, ratio, output, count);
+}
+}
+
+#else
+
+namespace simd
+{
+void getRatiosSse(float const* t, float* output, size_t count, TransitionFunction transition)
+{
+    getRatiosScalar(t, output, count, transition);
+}
+
+void lerpArraysSse(float const* start, float const* end, float ratio, float* output, size_t count)
+{
+    lerpArraysScalar(start, end, ratio, output, count);
+}
+}
+
+#endif
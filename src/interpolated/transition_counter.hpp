@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+#include "clock.hpp"
+
+
+/** Process wide tracking of the Interpolated values in transition.
+ *  isIdle compares the time with the latest end of transition, it is the check to skip animation work.
+ *  It is conservative: a transition replaced by a shorter one or destroyed early keeps it false until its former end.
+ *  getUnsettledCount counts the values whose end of transition was not observed by a read yet:
+ *  values finishing without being read stay counted until they are read, set again or destroyed.
+ *  Each thread updates its own cache line so that values set in parallel do not contend, queries aggregate all of them.
+ */
+struct TransitionCounter
+{
+    /// The number of per thread slots, threads beyond it share slots
+    static constexpr uint32_t slot_count = 64;
+
+    /// Returns true if no transition is running at @p time
+    [[nodiscard]]
+    static bool isIdle(Tick time)
+    {
+        return getUnsettledCount() == 0 || time >= getLastEndTime();
+    }
+
+    /// Returns true if no transition is running at the current time of @p TClock
+    template<typename TClock = SteadyClock>
+    [[nodiscard]]
+    static bool isIdle()
+    {
+        return isIdle(TClock::getTime());
+    }
+
+    /// Returns the number of values in transition or whose end of transition was not read yet
+    [[nodiscard]]
+    static uint32_t getUnsettledCount()
+    {
+        // A value can start on a thread and settle on another, slots are read one by one so partial sums can be negative
+        int64_t count{0};
+        for (Slot const& slot : s_slots) {
+            count += slot.count.load(std::memory_order_relaxed);
+        }
+        return static_cast<uint32_t>(std::max<int64_t>(count, 0));
+    }
+
+    /// Registers a value that started a transition
+    static void add()
+    {
+        getSlot().count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Unregisters a value whose transition is over
+    static void remove()
+    {
+        getSlot().count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// Records a transition ending at @p end_time
+    static void addEndTime(Tick end_time)
+    {
+        std::atomic<Tick>& last_end_time = getSlot().last_end_time;
+        Tick current = last_end_time.load(std::memory_order_relaxed);
+        while (current < end_time && !last_end_time.compare_exchange_weak(current, end_time, std::memory_order_relaxed)) {}
+    }
+
+private:
+    /// Slots only exist in static storage, which zero initializes them
+    struct alignas(64) Slot
+    {
+        std::atomic<int64_t> count;
+        /// The latest end of the transitions started from the threads using this slot
+        std::atomic<Tick>    last_end_time;
+    };
+
+    static inline Slot                  s_slots[slot_count];
+    static inline std::atomic<uint32_t> s_next_slot{0};
+
+    /// Returns the slot of the calling thread, assigned on first use
+    static Slot& getSlot()
+    {
+        static thread_local Slot* slot{nullptr};
+        if (!slot) {
+            slot = &s_slots[s_next_slot.fetch_add(1, std::memory_order_relaxed) % slot_count];
+        }
+        return *slot;
+    }
+
+    /// Returns the latest end of all the transitions started so far
+    [[nodiscard]]
+    static Tick getLastEndTime()
+    {
+        Tick last_end_time{0};
+        for (Slot const& slot : s_slots) {
+            last_end_time = std::max(last_end_time, slot.last_end_time.load(std::memory_order_relaxed));
+        }
+        return last_end_time;
+    }
+};
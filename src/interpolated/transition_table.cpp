@@ -0,0 +1,75 @@
+#include "transition_table.hpp"
+#include <cmath>
+#include <memory>
+
+
+TransitionTable::TransitionTable(TransitionFunction transition, uint32_t resolution)
+    : m_transition{transition}
+    , m_resolution{std::max(resolution, 1u)}
+    , m_scale{static_cast<float>(m_resolution)}
+{
+    m_values.resize(m_resolution + 1);
+    for (uint32_t i{0}; i < m_resolution; ++i) {
+        float const t = static_cast<float>(i) / m_scale;
+        m_values[i] = getAnalyticRatio(t, transition);
+    }
+    // Some functions jump to exactly 1 at the end (EaseOutElastic), use the left limit to not spread it over the last interval
+    m_values[m_resolution] = getAnalyticRatio(std::nextafter(1.0f, 0.0f), transition);
+}
+
+float TransitionTable::getMaxError(uint32_t sample_count) const
+{
+    float max_error{0.0f};
+    for (uint32_t i{0}; i < sample_count; ++i) {
+        float const t = static_cast<float>(i) / static_cast<float>(sample_count);
+        float const error = std::abs(sample(t) - getAnalyticRatio(t, m_transition));
+        max_error = std::max(max_error, error);
+    }
+    return max_error;
+}
+
+uint32_t TransitionTable::getResolutionFor(TransitionFunction transition, float max_error)
+{
+    // Largest resolution considered, 256KB per table
+    constexpr uint32_t max_resolution = 1 << 16;
+    uint32_t resolution{16};
+    while (resolution < max_resolution) {
+        TransitionTable const table{transition, resolution};
+        // Sampling between table points is where the error is maximal
+        if (table.getMaxError(resolution * 16) <= max_error) {
+            break;
+        }
+        resolution *= 2;
+    }
+    return resolution;
+}
+
+namespace
+{
+/// One slot per TransitionFunction entry
+constexpr size_t table_slots = 16;
+std::unique_ptr<TransitionTable> s_tables[table_slots];
+}
+
+void setTransitionTable(TransitionFunction transition, uint32_t resolution)
+{
+    auto const index = static_cast<size_t>(transition);
+    if (index >= table_slots) {
+        return;
+    }
+    if (resolution == 0) {
+        s_tables[index] = nullptr;
+    } else {
+        s_tables[index] = std::make_unique<TransitionTable>(transition, resolution);
+    }
+    TransitionTables::s_enabled = std::any_of(std::begin(s_tables), std::end(s_tables), [](auto const& table) { return table != nullptr; });
+}
+
+TransitionTable const* getTransitionTable(TransitionFunction transition)
+{
+    auto const index = static_cast<size_t>(transition);
+    if (index >= table_slots) {
+        return nullptr;
+    }
+    return s_tables[index].get();
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "functions.hpp"
+
+
+/** A transition function tabulated once over [0, 1) and sampled with linear interpolation.
+ *  The interpolation error decreases with the square of the resolution, use
+ *  @p getResolutionFor to find the smallest table matching an error budget.
+ *  Completed transitions (t >= 1) are expected to be handled by the caller, as Interpolated does.
+ */
+class TransitionTable
+{
+public:
+    /// Tabulates @p transition using @p resolution intervals
+    TransitionTable(TransitionFunction transition, uint32_t resolution);
+
+    /// Returns the tabulated ratio at @p t, clamped to [0, 1]
+    [[nodiscard]]
+    float sample(float t) const
+    {
+        float const x = std::min(std::max(t, 0.0f), 1.0f) * m_scale;
+        auto const index = std::min(static_cast<uint32_t>(x), m_resolution - 1);
+        float const f = x - static_cast<float>(index);
+        float const a = m_values[index];
+        float const b = m_values[index + 1];
+        return a + (b - a) * f;
+    }
+
+    /// Returns the number of intervals of the table
+    [[nodiscard]]
+    uint32_t getResolution() const
+    {
+        return m_resolution;
+    }
+
+    /// Returns the table's size in bytes
+    [[nodiscard]]
+    size_t getByteSize() const
+    {
+        return m_values.size() * sizeof(float);
+    }
+
+    /// Returns the maximum absolute difference with the analytic function, measured on @p sample_count points in [0, 1)
+    [[nodiscard]]
+    float getMaxError(uint32_t sample_count = 1'000'000) const;
+
+    /// Returns the smallest power of two resolution keeping the error under @p max_error
+    [[nodiscard]]
+    static uint32_t getResolutionFor(TransitionFunction transition, float max_error);
+
+private:
+    /// The transition function
+    TransitionFunction m_transition;
+    /// The number of intervals
+    uint32_t m_resolution;
+    /// Converts t into table space
+    float m_scale;
+    /// The tabulated values, one more than the resolution to include t = 1
+    std::vector<float> m_values;
+};
+
+/** Makes getRatio sample a table of @p resolution intervals for @p transition instead of evaluating it.
+ *  A resolution of 0 restores the analytic function. Tables are meant to be configured at startup,
+ *  this is not thread safe with concurrent calls to getRatio or getRatios, which both sample the table.
+ */
+void setTransitionTable(TransitionFunction transition, uint32_t resolution);
+
+/// Returns the table used by getRatio for @p transition, nullptr if it is evaluated analytically
+TransitionTable const* getTransitionTable(TransitionFunction transition);
@@ -118,7 +118,7 @@ protected:
         auto const count = data.size();
 
         auto& tp{Singleton<ThreadPool>::get()};
-        tp.dispatch(count, [&data, callback](uint32_t const start, uint32_t const end) {
+        tp.parallelFor(count, ThreadPool::getAlignedGrain<TEntity>(1), [&data, callback](uint32_t const start, uint32_t const end) {
             for (uint32_t i{start}; i < end; ++i) {
                 if (!data[i].removeRequested()) {
                     callback(i, data[i]);
@@ -134,7 +134,7 @@ protected:
         auto const count = data.size();
 
         auto& tp{Singleton<ThreadPool>::get()};
-        tp.dispatch(count, [&data, callback](uint32_t const start, uint32_t const end) {
+        tp.parallelFor(count, ThreadPool::getAlignedGrain<TEntity>(1), [&data, callback](uint32_t const start, uint32_t const end) {
             for (uint32_t i{start}; i < end; ++i) {
                 if (!data[i].removeRequested()) {
                     callback(data[i]);
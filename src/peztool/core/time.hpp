@@ -0,0 +1,36 @@
+#pragma once
+#include "interpolated/clock.hpp"
+
+
+namespace pez
+{
+
+/** The application time in seconds, advanced by App::tick while the application is running.
+ *  It lives outside of App so that code only depending on time, like interpolation, does not need a window.
+ *  It is accumulated in integer ticks so that it matches exactly the simulated clock advanced with the same steps.
+ */
+struct Time
+{
+    /// Returns the current application time in seconds
+    static float get()
+    {
+        return toSeconds(s_ticks);
+    }
+
+    /// Moves the application time forward by @p dt seconds
+    static void advance(float dt)
+    {
+        s_ticks += toTicks(dt);
+    }
+
+    /// Returns the current application time in ticks
+    static Tick getTicks()
+    {
+        return s_ticks;
+    }
+
+private:
+    static inline Tick s_ticks = 0;
+};
+
+}
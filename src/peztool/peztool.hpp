@@ -1,8 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 
+#include "interpolated/clock.hpp"
 #include "peztool/core/scene.hpp"
 #include "peztool/core/static_interface.hpp"
+#include "peztool/core/time.hpp"
 #include "utils/thread_pool.hpp"
 
 
@@ -65,11 +67,21 @@ public:
         }
     }
 
+    /// Ticks @p frame_count times, with simulated time and no frame rate limit this runs faster than real time
+    void runFrames(uint32_t frame_count)
+    {
+        for (uint32_t i{0}; i < frame_count && m_window.isOpen(); ++i) {
+            tick(m_dt);
+        }
+    }
+
     /// Closes the window and stops the application
     void close() { m_window.close(); }
 
     void tick(float const dt)
     {
+        // Sample time once so all the interpolated values read during this tick are consistent
+        FrameClock::sample();
         if (m_current_scene) {
             m_current_scene->setRunning(m_running);
             m_current_scene->tick(dt);
@@ -78,8 +90,11 @@ public:
             exit();
         }
         if (m_running) {
-            // Update time
-            m_time += dt;
+            // Update time, the simulated clock follows the same steps
+            Time::advance(dt);
+            if (SimulatedClock::isEnabled()) {
+                SimulatedClock::advance(toTicks(dt));
+            }
         }
     }
 
@@ -105,7 +120,19 @@ public:
 
     static float getTime()
     {
-        return GlobalInstance<App>::instance->m_time;
+        return Time::get();
+    }
+
+    /** Makes every interpolation read the application time instead of the system clock.
+     *  Time then only moves by the fixed steps of @p tick, runs are deterministic and not bound to real time.
+     */
+    static void setSimulatedTime(bool enabled)
+    {
+        if (enabled) {
+            SimulatedClock::enable(Time::getTicks());
+        } else {
+            SimulatedClock::disable();
+        }
     }
 
     static void exit()
@@ -150,7 +177,6 @@ private:
 
     uint32_t m_tick_rate;
     float    m_dt;
-    float    m_time = 0.0f;
 
     bool m_running = true;
     bool m_frame_rate_unlocked = false;
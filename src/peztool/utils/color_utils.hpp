@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <SFML/Graphics/Color.hpp>
+
+#include "./vec.hpp"
+#include "./packed_color.hpp"
+
+
+namespace pez
+{
+
+/// Returns the channels of @p color as a vector of floats in [0, 255]
+template<typename TVec>
+TVec getVec(sf::Color color)
+{
+    return {static_cast<float>(color.r), static_cast<float>(color.g), static_cast<float>(color.b), static_cast<float>(color.a)};
+}
+
+/// Returns the color from a vector of floats in [0, 255], out of range channels are clamped
+inline sf::Color getColor(Vec4f const& v)
+{
+    auto const toChannel = [](float f) {
+        return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, f)));
+    };
+    return {toChannel(v.x), toChannel(v.y), toChannel(v.z), toChannel(v.w)};
+}
+
+inline PackedColor getPacked(sf::Color color)
+{
+    return packColor(color.r, color.g, color.b, color.a);
+}
+
+inline sf::Color getColor(PackedColor color)
+{
+    return {getChannel(color, 0), getChannel(color, 1), getChannel(color, 2), getChannel(color, 3)};
+}
+
+}
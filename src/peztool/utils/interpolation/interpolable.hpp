@@ -1,22 +1,35 @@
 #pragma once
+#include <algorithm>
 #include "./interpolation.hpp"
 
 
 namespace pez
 {
 
-struct Interpolable
+/** Interpolation state without virtual functions, @p TDerived provides `float getTime() const`.
+ *  Objects do not carry a vtable pointer and time retrieval is inlined in the ratio computation.
+ *  @p TDerived has to declare this class as friend if its getTime is not public.
+ */
+template<typename TDerived>
+struct StaticInterpolable
 {
 public:
-    virtual ~Interpolable() = default;
-
     /// Checks if the interpolation is over
     [[nodiscard]]
-    virtual bool isDone() const
+    bool isDone() const
     {
         return getTimeRatio() >= 1.0f;
     }
 
+    /** Checks if the value may have changed after @p time, in the time base of @p getTime.
+     *  Renderers can skip rebuilding geometry depending on values that did not change since their last update.
+     */
+    [[nodiscard]]
+    bool hasChangedSince(float time) const
+    {
+        return std::max(m_change_time, m_start_time + 1.0f / m_speed) >= time;
+    }
+
     /// Sets the function used for interpolation
     void setInterpolationFunction(InterpolationFunction function)
     {
@@ -34,7 +47,7 @@ protected:
     [[nodiscard]]
     float getTimeRatio() const
     {
-        float const current_time = getTime();
+        float const current_time = getCurrentTime();
         return std::max(0.0f, (current_time - m_start_time) * m_speed);
     }
 
@@ -42,32 +55,67 @@ protected:
     [[nodiscard]]
     float getValueRatio() const
     {
-        return Interpolation::getInterpolationValue(getTimeRatio(), m_function);
+        return getValueRatio(getTimeRatio());
+    }
+
+    /// Returns the value ratio at @p time_ratio, avoids reading the time twice when it is already known
+    [[nodiscard]]
+    float getValueRatio(float time_ratio) const
+    {
+        return Interpolation::getInterpolationValue(time_ratio, m_function);
     }
 
     /// Sets the current time to now
     void reset()
     {
-        m_start_time = getTime();
+        m_start_time = getCurrentTime();
+        m_change_time = m_start_time;
     }
 
     /// Sets the start time in order to make the @p Interpolable done
     void setDone()
     {
         // Doubling the value to be sure
-        m_start_time = getTime() - 2.0f / m_speed;
+        m_change_time = getCurrentTime();
+        m_start_time = m_change_time - 2.0f / m_speed;
     }
 
-    /// Returns the current time. Has to be defined by the user.
-    [[nodiscard]]
-    virtual float getTime() const = 0;
-
 private:
     /// The starting time for the interpolation
     float m_start_time = 0.0f;
+    /// The time of the last value change, needed because instant changes move the start time in the past
+    float m_change_time = 0.0f;
     /// The time multiplier to set interpolation speed
     float m_speed = 1.0f;
     /// The function that will be used for interpolation
     InterpolationFunction m_function = InterpolationFunction::EaseInOutQuint;
+
+    /// Returns the time provided by the derived class
+    [[nodiscard]]
+    float getCurrentTime() const
+    {
+        return static_cast<TDerived const&>(*this).getTime();
+    }
+};
+
+/// Runtime polymorphic version, for code that needs to handle different interpolables through a base pointer
+struct Interpolable : public StaticInterpolable<Interpolable>
+{
+public:
+    virtual ~Interpolable() = default;
+
+    /// Checks if the interpolation is over
+    [[nodiscard]]
+    virtual bool isDone() const
+    {
+        return StaticInterpolable::isDone();
+    }
+
+protected:
+    /// Returns the current time. Has to be defined by the user.
+    [[nodiscard]]
+    virtual float getTime() const = 0;
+
+    friend StaticInterpolable<Interpolable>;
 };
 }
@@ -1,6 +1,6 @@
 #pragma once
-#include "peztool/core/vec.hpp"
-#include "peztool/peztool.hpp"
+#include "peztool/core/time.hpp"
+#include "peztool/utils/vec.hpp"
 
 #include "./interpolation.hpp"
 
@@ -73,7 +73,7 @@ public:
 
     [[nodiscard]]
     float getElapsedTime() const {
-        return (App::getTime() - start_time) * m_speed;
+        return (Time::get() - start_time) * m_speed;
     }
 
     [[nodiscard]]
@@ -103,7 +103,7 @@ public:
     }
 
     void updateStartTime(float offset = 0.0f) {
-        start_time = App::getTime() - offset;
+        start_time = Time::get() - offset;
     }
 
     [[nodiscard]]
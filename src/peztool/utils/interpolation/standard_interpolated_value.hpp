@@ -1,5 +1,5 @@
 #pragma once
-#include "../../peztool.hpp"
+#include "../../core/time.hpp"
 #include "../../utils/vec.hpp"
 #include "../color_utils.hpp"
 #include "./interpolable.hpp"
@@ -8,16 +8,16 @@
 namespace pez
 {
 
-/// Base class for standard InterpolatedData
+/// Standard interpolated value following the application time, it has no virtual function
 template<typename TData>
-struct InterpolatedData : public Interpolable
+struct InterpolatedData : public StaticInterpolable<InterpolatedData<TData>>
 {
 public:
     InterpolatedData(TData const& value, InterpolationFunction function, float speed)
     {
         setValueDirect(value);
-        setInterpolationFunction(function);
-        setInterpolationSpeed(speed);
+        this->setInterpolationFunction(function);
+        this->setInterpolationSpeed(speed);
     }
 
     InterpolatedData(TData const& value, InterpolationFunction function)
@@ -40,15 +40,13 @@ public:
         : InterpolatedData({}, InterpolationFunction::EaseInOutQuint, 1.0f)
     {}
 
-    ~InterpolatedData() override = default;
-
     /// Sets a new target for the value
     void setValue(TData const& value)
     {
         m_start_value  = getCurrentValue();
         m_target_value = value;
         m_delta        = m_target_value - m_start_value;
-        reset();
+        this->reset();
     }
 
     /// Instantly sets the current value to the provided one
@@ -57,7 +55,7 @@ public:
         m_start_value  = value;
         m_target_value = value;
         m_delta        = {};
-        setDone();
+        this->setDone();
     }
 
     /// Adds the provided offset to the current value
@@ -79,10 +77,11 @@ public:
     }
 
     [[nodiscard]]
-    virtual TData getCurrentValue() const
+    TData getCurrentValue() const
     {
-        if (!isDone()) {
-            return m_start_value + m_delta * getValueRatio();
+        float const time_ratio = this->getTimeRatio();
+        if (time_ratio < 1.0f) {
+            return m_start_value + m_delta * this->getValueRatio(time_ratio);
         }
         return m_target_value;
     }
@@ -99,10 +98,12 @@ public:
     }
 
 protected:
+    friend StaticInterpolable<InterpolatedData>;
+
     [[nodiscard]]
-    float getTime() const override
+    float getTime() const
     {
-        float const time{App::getTime()};
+        float const time{Time::get()};
         return time;
     }
 
@@ -118,24 +119,42 @@ using InterpolatedVec3  = InterpolatedData<Vec3f>;
 using InterpolatedVec4  = InterpolatedData<Vec4f>;
 
 
-/// Specialization for Colors
+/** Specialization for Colors.
+ *  Colors are stored packed on 32 bits and blended with integer arithmetic, see packed_color.hpp.
+ *  Blending happens in sRGB space by default, linear light blending avoids darkened midpoints and banding.
+ *  Ratios outside [0, 1], from EaseOutBack or EaseOutElastic for instance, extrapolate with float math and clamp each channel.
+ */
 template<>
-struct InterpolatedData<sf::Color> final : public Interpolable
+struct InterpolatedData<sf::Color> final : public StaticInterpolable<InterpolatedData<sf::Color>>
 {
 public:
+    /// The color space used to blend start and target colors
+    enum class BlendMode
+    {
+        Srgb,
+        Linear
+    };
+
+    InterpolatedData() = default;
+
+    explicit
+    InterpolatedData(sf::Color color, BlendMode mode = BlendMode::Srgb)
+        : m_blend_mode{mode}
+    {
+        setValueDirect(color);
+    }
+
     void setValue(sf::Color color)
     {
-        m_start_value  = getVec4CurrentValue();
-        m_target_value = pez::getVec<Vec4f>(color);
-        m_delta        = m_target_value - m_start_value;
+        m_start_value  = getPackedCurrentValue();
+        m_target_value = getPacked(color);
         reset();
     }
 
     void setValueDirect(sf::Color color)
     {
-        m_start_value  = pez::getVec<Vec4f>(color);
+        m_start_value  = getPacked(color);
         m_target_value = m_start_value;
-        m_delta        = {};
         setDone();
     }
 
@@ -144,6 +163,12 @@ public:
         setValue(color);
     }
 
+    /// Sets the color space used for blending
+    void setBlendMode(BlendMode mode)
+    {
+        m_blend_mode = mode;
+    }
+
     /// Casts the value to the underlying type by returning the current value
     operator sf::Color() const
     {
@@ -153,29 +178,44 @@ public:
     [[nodiscard]]
     sf::Color getCurrentValue() const
     {
-        return pez::getColor(getVec4CurrentValue());
+        return getColor(getPackedCurrentValue());
     }
 
-private:
+    /// Returns the current value packed as RGBA8
     [[nodiscard]]
-    float getTime() const override
+    PackedColor getPackedCurrentValue() const
     {
-        return App::getTime();
+        float const time_ratio = getTimeRatio();
+        if (time_ratio >= 1.0f) {
+            return m_target_value;
+        }
+        float const ratio = getValueRatio(time_ratio);
+        // Overshooting transitions extrapolate past the colors like other types, channels are then clamped
+        if (ratio < 0.0f || ratio > 1.0f) {
+            if (m_blend_mode == BlendMode::Linear) {
+                return extrapolatePackedLinear(m_start_value, m_target_value, ratio);
+            }
+            return extrapolatePacked(m_start_value, m_target_value, ratio);
+        }
+        BlendWeight const weight = getBlendWeight(ratio);
+        if (m_blend_mode == BlendMode::Linear) {
+            return blendPackedLinear(m_start_value, m_target_value, weight);
+        }
+        return blendPacked(m_start_value, m_target_value, weight);
     }
 
+private:
+    friend StaticInterpolable<InterpolatedData>;
+
     [[nodiscard]]
-    Vec4f getVec4CurrentValue() const
+    float getTime() const
     {
-        float const ratio = getValueRatio();
-        if (ratio < 1.0f) {
-            return m_start_value + m_delta * ratio;
-        }
-        return m_target_value;
+        return Time::get();
     }
 
-    Vec4f m_start_value;
-    Vec4f m_target_value;
-    Vec4f m_delta;
+    PackedColor m_start_value{0};
+    PackedColor m_target_value{0};
+    BlendMode   m_blend_mode{BlendMode::Srgb};
 };
 
 }
\ No newline at end of file
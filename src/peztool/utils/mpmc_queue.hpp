@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+
+namespace pez
+{
+
+/** Bounded lock-free queue for any number of producers and consumers (Vyukov's algorithm).
+ *  Each cell carries a sequence number telling whether it is ready to be written or read,
+ *  so threads only contend on the CAS claiming a position.
+ */
+template<typename T>
+class MpmcQueue
+{
+public:
+    /// The capacity is rounded up to a power of two
+    explicit
+    MpmcQueue(size_t capacity)
+    {
+        size_t rounded_capacity{2};
+        while (rounded_capacity < capacity) {
+            rounded_capacity *= 2;
+        }
+        m_mask = rounded_capacity - 1;
+        m_cells = std::make_unique<Cell[]>(rounded_capacity);
+        for (size_t i{0}; i < rounded_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(MpmcQueue const&) = delete;
+    MpmcQueue& operator=(MpmcQueue const&) = delete;
+
+    ~MpmcQueue()
+    {
+        T item;
+        while (tryPop(item)) {}
+    }
+
+    /// Moves @p item in the queue, returns false and leaves @p item untouched if the queue is full
+    bool tryPush(T&& item)
+    {
+        size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &m_cells[position & m_mask];
+            size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::move(item));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Moves the oldest item to @p item, returns false if the queue is empty
+    bool tryPop(T& item)
+    {
+        size_t position = m_dequeue_position.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &m_cells[position & m_mask];
+            size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+        T* const stored = std::launder(reinterpret_cast<T*>(cell->storage));
+        item = std::move(*stored);
+        stored->~T();
+        // The cell can be written again on the next lap
+        cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Returns true if the queue looked empty, the result can be outdated as soon as it is returned
+    [[nodiscard]]
+    bool empty() const
+    {
+        return m_enqueue_position.load(std::memory_order_relaxed) == m_dequeue_position.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t                  m_mask = 0;
+    // Producers and consumers do not share cache lines
+    alignas(cache_line_size) std::atomic<size_t> m_enqueue_position{0};
+    alignas(cache_line_size) std::atomic<size_t> m_dequeue_position{0};
+};
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+
+namespace pez
+{
+
+/* ----- Packed RGBA8 colors -----
+   A color is stored in a single 32 bits integer, one byte per channel with red in the lowest byte,
+   which is also the memory layout of sf::Color on little endian targets.
+   Blending processes two channels per 32 bits operation (SWAR) and batch loops are branch free
+   so that compilers can vectorize them, blending several colors per instruction.
+*/
+
+using PackedColor = uint32_t;
+
+/// Fixed point blending weight, 0 selects the start color and 256 the target one
+using BlendWeight = uint32_t;
+constexpr BlendWeight blend_weight_one = 256;
+
+constexpr PackedColor packColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+{
+    return static_cast<PackedColor>(r) | (static_cast<PackedColor>(g) << 8) | (static_cast<PackedColor>(b) << 16) | (static_cast<PackedColor>(a) << 24);
+}
+
+constexpr uint8_t getChannel(PackedColor color, uint32_t channel)
+{
+    return static_cast<uint8_t>(color >> (8 * channel));
+}
+
+/// Converts an easing ratio to a blending weight, overshooting ratios are clamped, see extrapolatePacked
+inline BlendWeight getBlendWeight(float ratio)
+{
+    float const clamped = std::min(1.0f, std::max(0.0f, ratio));
+    return static_cast<BlendWeight>(clamped * static_cast<float>(blend_weight_one) + 0.5f);
+}
+
+/// Blends the 4 channels of @p a and @p b in sRGB space, two channels at a time
+constexpr PackedColor blendPacked(PackedColor a, PackedColor b, BlendWeight weight)
+{
+    constexpr uint32_t mask = 0x00FF00FF;
+    uint32_t const inv_weight = blend_weight_one - weight;
+    // Red and blue, then green and alpha, each channel has 8 spare bits for the product
+    uint32_t const rb = (((a & mask) * inv_weight + (b & mask) * weight) >> 8) & mask;
+    uint32_t const ga = ((((a >> 8) & mask) * inv_weight + ((b >> 8) & mask) * weight) >> 8) & mask;
+    return rb | (ga << 8);
+}
+
+/** Precomputed conversions between sRGB and linear light.
+ *  Linear values use 16 bits, the inverse table is indexed with the 12 most significant ones,
+ *  which is enough for every 8 bits sRGB value to survive a round trip.
+ */
+struct SrgbTables
+{
+    static constexpr uint32_t linear_bits = 12;
+    static constexpr uint32_t linear_shift = 16 - linear_bits;
+
+    uint16_t to_linear[256];
+    uint8_t to_srgb[1 << linear_bits];
+
+    SrgbTables()
+    {
+        for (uint32_t i{0}; i < 256; ++i) {
+            double const c = i / 255.0;
+            double const linear = (c <= 0.04045) ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+            to_linear[i] = static_cast<uint16_t>(std::lround(linear * 65535.0));
+        }
+        constexpr uint32_t count = 1 << linear_bits;
+        for (uint32_t i{0}; i < count; ++i) {
+            // Center of the bucket so that rounding is symmetric
+            double const linear = (i + 0.5) / static_cast<double>(count);
+            double const c = (linear <= 0.0031308) ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+            to_srgb[i] = static_cast<uint8_t>(std::lround(std::min(1.0, c) * 255.0));
+        }
+        // Keep black and white exact
+        to_srgb[0] = 0;
+        to_srgb[count - 1] = 255;
+    }
+
+    static SrgbTables const& get()
+    {
+        static SrgbTables const tables;
+        return tables;
+    }
+};
+
+/// Blends @p a and @p b in linear light, alpha is not gamma encoded and is blended directly
+inline PackedColor blendPackedLinear(PackedColor a, PackedColor b, BlendWeight weight)
+{
+    SrgbTables const& tables = SrgbTables::get();
+    uint32_t const inv_weight = blend_weight_one - weight;
+    PackedColor result{0};
+    for (uint32_t channel{0}; channel < 3; ++channel) {
+        uint32_t const la = tables.to_linear[getChannel(a, channel)];
+        uint32_t const lb = tables.to_linear[getChannel(b, channel)];
+        uint32_t const linear = (la * inv_weight + lb * weight) >> 8;
+        result |= static_cast<PackedColor>(tables.to_srgb[linear >> SrgbTables::linear_shift]) << (8 * channel);
+    }
+    uint32_t const alpha = (getChannel(a, 3) * inv_weight + getChannel(b, 3) * weight) >> 8;
+    return result | (alpha << 24);
+}
+
+/// Extrapolates @p a and @p b in sRGB space for ratios outside [0, 1], channels are clamped to [0, 255]
+inline PackedColor extrapolatePacked(PackedColor a, PackedColor b, float ratio)
+{
+    PackedColor result{0};
+    for (uint32_t channel{0}; channel < 4; ++channel) {
+        float const start = getChannel(a, channel);
+        float const value = start + (static_cast<float>(getChannel(b, channel)) - start) * ratio;
+        result |= static_cast<PackedColor>(std::min(255.0f, std::max(0.0f, value))) << (8 * channel);
+    }
+    return result;
+}
+
+/// Extrapolates @p a and @p b in linear light for ratios outside [0, 1], channels are clamped to the valid range
+inline PackedColor extrapolatePackedLinear(PackedColor a, PackedColor b, float ratio)
+{
+    SrgbTables const& tables = SrgbTables::get();
+    PackedColor result{0};
+    for (uint32_t channel{0}; channel < 3; ++channel) {
+        float const start = tables.to_linear[getChannel(a, channel)];
+        float const value = start + (static_cast<float>(tables.to_linear[getChannel(b, channel)]) - start) * ratio;
+        auto const linear = static_cast<uint32_t>(std::min(65535.0f, std::max(0.0f, value)));
+        result |= static_cast<PackedColor>(tables.to_srgb[linear >> SrgbTables::linear_shift]) << (8 * channel);
+    }
+    float const start = getChannel(a, 3);
+    float const alpha = start + (static_cast<float>(getChannel(b, 3)) - start) * ratio;
+    return result | (static_cast<PackedColor>(std::min(255.0f, std::max(0.0f, alpha))) << 24);
+}
+
+/// Blends @p count colors in sRGB space, the loop is branch free to allow vectorization
+inline void blendPacked(PackedColor const* start, PackedColor const* target, BlendWeight const* weights, PackedColor* output, size_t count)
+{
+    for (size_t i{0}; i < count; ++i) {
+        output[i] = blendPacked(start[i], target[i], weights[i]);
+    }
+}
+
+/// Blends @p count colors in linear light
+inline void blendPackedLinear(PackedColor const* start, PackedColor const* target, BlendWeight const* weights, PackedColor* output, size_t count)
+{
+    for (size_t i{0}; i < count; ++i) {
+        output[i] = blendPackedLinear(start[i], target[i], weights[i]);
+    }
+}
+
+}
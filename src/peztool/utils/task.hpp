@@ -0,0 +1,130 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace pez
+{
+
+/** Type erased void() callable, move only.
+ *  Callables up to inline_capacity bytes are stored inline, unlike std::function no capture of that size allocates.
+ *  Larger callables are allocated on the heap.
+ */
+class Task
+{
+public:
+    static constexpr size_t inline_capacity = 48;
+
+    Task() = default;
+
+    template<typename TCallback, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TCallback>, Task>>>
+    Task(TCallback&& callback)
+    {
+        using Callable = std::decay_t<TCallback>;
+        if constexpr (isInline<Callable>()) {
+            new (m_storage) Callable(std::forward<TCallback>(callback));
+            m_operations = &inline_operations<Callable>;
+        } else {
+            new (m_storage) Callable*(new Callable(std::forward<TCallback>(callback)));
+            m_operations = &heap_operations<Callable>;
+        }
+    }
+
+    Task(Task&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    ~Task()
+    {
+        reset();
+    }
+
+    void operator()()
+    {
+        m_operations->invoke(m_storage);
+    }
+
+    /// Destroys the callable and its captures
+    void reset()
+    {
+        if (m_operations) {
+            m_operations->destroy(m_storage);
+            m_operations = nullptr;
+        }
+    }
+
+    [[nodiscard]]
+    explicit operator bool() const
+    {
+        return m_operations != nullptr;
+    }
+
+private:
+    struct Operations
+    {
+        void (*invoke)(void* storage);
+        /// Moves the callable of @p source to @p target and destroys the one of @p source
+        void (*relocate)(void* target, void* source);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename TCallable>
+    static constexpr bool isInline()
+    {
+        return sizeof(TCallable) <= inline_capacity
+            && alignof(TCallable) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<TCallable>;
+    }
+
+    template<typename T>
+    static T* get(void* storage)
+    {
+        return std::launder(static_cast<T*>(storage));
+    }
+
+    template<typename TCallable>
+    static constexpr Operations inline_operations{
+        [](void* storage) { (*get<TCallable>(storage))(); },
+        [](void* target, void* source) {
+            new (target) TCallable(std::move(*get<TCallable>(source)));
+            get<TCallable>(source)->~TCallable();
+        },
+        [](void* storage) { get<TCallable>(storage)->~TCallable(); },
+    };
+
+    template<typename TCallable>
+    static constexpr Operations heap_operations{
+        [](void* storage) { (**get<TCallable*>(storage))(); },
+        [](void* target, void* source) { new (target) TCallable*(*get<TCallable*>(source)); },
+        [](void* storage) { delete *get<TCallable*>(storage); },
+    };
+
+    alignas(std::max_align_t) unsigned char m_storage[inline_capacity];
+    Operations const*                       m_operations = nullptr;
+
+    void moveFrom(Task& other)
+    {
+        if (other.m_operations) {
+            other.m_operations->relocate(m_storage, other.m_storage);
+            m_operations = other.m_operations;
+            other.m_operations = nullptr;
+        }
+    }
+};
+
+}
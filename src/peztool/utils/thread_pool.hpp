@@ -1,104 +1,187 @@
 #pragma once
-#include <functional>
-#include <queue>
+#include <algorithm>
+#include <memory>
+#include <numeric>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+
+#include "task.hpp"
+#include "mpmc_queue.hpp"
+#include "work_stealing_deque.hpp"
 
 
 namespace pez
 {
 
-struct TaskQueue
+struct Worker;
+class TaskGroup;
+
+/// A task waiting to be run, with the group it belongs to if any
+struct PendingTask
 {
-    std::queue<std::function<void()>> m_tasks;
-    std::mutex                        m_mutex;
-    std::atomic<uint32_t>             m_remaining_tasks = 0;
+    Task       task;
+    TaskGroup* group = nullptr;
+};
 
-    template<typename TCallback>
-    void addTask(TCallback&& callback)
-    {
-        std::lock_guard<std::mutex> lock_guard{m_mutex};
-        m_tasks.push(std::forward<TCallback>(callback));
-        ++m_remaining_tasks;
-    }
+/// Task stored in a worker deque, recycled by the worker that allocated it so that adding tasks does not allocate
+struct TaskNode
+{
+    PendingTask pending;
+    TaskNode*   next  = nullptr;
+    Worker*     owner = nullptr;
+};
 
-    void getTask(std::function<void()>& target_callback)
-    {
-        {
-            std::lock_guard<std::mutex> lock_guard{m_mutex};
-            if (m_tasks.empty()) {
-                return;
-            }
-            target_callback = std::move(m_tasks.front());
-            m_tasks.pop();
-        }
-    }
+struct ThreadPool;
 
-    static void wait()
-    {
-        std::this_thread::yield();
-    }
+/** Set of tasks that can be waited for independently of the other tasks of the pool.
+ *  Tasks are added with ThreadPool::addTask(group, callback) and waited for with ThreadPool::wait(group),
+ *  so that several batches can be in flight at once without waiting for each other.
+ *  The group has to outlive its tasks.
+ */
+class TaskGroup
+{
+public:
+    TaskGroup() = default;
+    TaskGroup(TaskGroup const&) = delete;
+    TaskGroup& operator=(TaskGroup const&) = delete;
 
-    void waitForCompletion() const
+    /// Returns true if all the tasks added so far are done
+    [[nodiscard]]
+    bool isDone() const
     {
-        while (m_remaining_tasks > 0) {
-            wait();
-        }
+        return m_remaining_tasks.load(std::memory_order_acquire) == 0;
     }
 
-    void workDone()
+private:
+    std::atomic<uint32_t> m_remaining_tasks = 0;
+
+    friend struct ThreadPool;
+};
+
+/// Shared state of a ThreadPool::parallelFor call
+struct ParallelForJob
+{
+    size_t                count             = 0;
+    size_t                grain             = 1;
+    uint32_t              participant_count = 1;
+    std::atomic<size_t>   next              = 0;
+
+    /// Claims the next chunk, each one taking a share of what remains but at least the grain, returns false when none is left
+    bool claim(size_t& start, size_t& end)
     {
-        m_remaining_tasks--;
+        start = next.load(std::memory_order_relaxed);
+        do {
+            if (start >= count) {
+                return false;
+            }
+            size_t const share = (count - start) / (2 * participant_count);
+            size_t const size = std::max(grain, share - share % grain);
+            end = std::min(count, start + size);
+        } while (!next.compare_exchange_weak(start, end, std::memory_order_relaxed));
+        return true;
     }
 };
 
+/** Workers first run the tasks of their own deque, then steal from random workers and finally take from the shared queue.
+ *  Tasks added from a worker go to its deque, tasks added from other threads go to the shared lock-free queue.
+ *  They spin for a while when there is nothing to do, then park until a task is added.
+ *  The spin duration adapts: it grows when tasks arrive while spinning and shrinks when the worker has to park.
+ */
 struct Worker
 {
-    uint32_t              m_id      = 0;
-    std::thread           m_thread;
-    std::function<void()> m_task    = nullptr;
-    bool                  m_running = true;
-    TaskQueue*            m_queue   = nullptr;
+    static constexpr uint32_t min_spin_count = 16;
+    static constexpr uint32_t max_spin_count = 4096;
+
+    uint32_t                               m_id             = 0;
+    std::thread                            m_thread;
+    std::atomic<bool>                      m_running        = true;
+    ThreadPool*                            m_pool           = nullptr;
+    WorkStealingDeque<TaskNode*>           m_deque;
+    uint32_t                               m_spin_count     = min_spin_count;
+    uint32_t                               m_random_state   = 0;
 
-    Worker() = default;
+    /// Recycled nodes, only used by the worker thread
+    TaskNode*                              m_free_nodes     = nullptr;
+    /// Nodes released by other threads, they push them and the worker takes them all at once
+    std::atomic<TaskNode*>                 m_released_nodes = nullptr;
+    /// All the nodes allocated by this worker
+    std::vector<std::unique_ptr<TaskNode>> m_nodes;
 
-    Worker(TaskQueue& queue, uint32_t id)
+    Worker(ThreadPool& pool, uint32_t id)
         : m_id{id}
-        , m_queue{&queue}
+        , m_pool{&pool}
+        , m_random_state{id * 0x9E3779B9u + 1}
+    {}
+
+    /// Xorshift, used to pick the workers to steal from
+    uint32_t getRandom()
     {
-        m_thread = std::thread([this](){
-            run();
-        });
+        m_random_state ^= m_random_state << 13;
+        m_random_state ^= m_random_state >> 17;
+        m_random_state ^= m_random_state << 5;
+        return m_random_state;
     }
 
-    void run()
+    /// Returns an unused node, only allocates when all the nodes are in use, worker thread only
+    TaskNode* allocateNode()
     {
-        while (m_running) {
-            m_queue->getTask(m_task);
-            if (m_task == nullptr) {
-                TaskQueue::wait();
-            } else {
-                m_task();
-                m_queue->workDone();
-                m_task = nullptr;
-            }
+        if (!m_free_nodes) {
+            m_free_nodes = m_released_nodes.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (TaskNode* const node = m_free_nodes) {
+            m_free_nodes = node->next;
+            return node;
+        }
+        m_nodes.push_back(std::make_unique<TaskNode>());
+        m_nodes.back()->owner = this;
+        return m_nodes.back().get();
+    }
+
+    /// Gives back a node of this worker, @p current_worker is the worker of the calling thread if any
+    void releaseNode(TaskNode* node, Worker const* current_worker)
+    {
+        if (current_worker == this) {
+            node->next = m_free_nodes;
+            m_free_nodes = node;
+            return;
         }
+        // Push only stack, the worker takes the whole list so there is no ABA issue
+        TaskNode* head = m_released_nodes.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!m_released_nodes.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
     }
 
-    void stop()
+    void requestStop()
     {
         m_running = false;
+    }
+
+    void join()
+    {
         m_thread.join();
     }
 };
 
 struct ThreadPool final
 {
-    uint32_t            m_thread_count = 0;
-    TaskQueue           m_queue;
-    std::vector<Worker> m_workers;
+    /// Capacity of the shared queue, threads adding tasks to a full queue run pending ones until there is room
+    static constexpr size_t queue_capacity = 4096;
+
+    uint32_t                             m_thread_count    = 0;
+    MpmcQueue<PendingTask>               m_queue{queue_capacity};
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<uint32_t>                m_remaining_tasks = 0;
+
+    std::mutex                           m_park_mutex;
+    std::condition_variable              m_park_condition;
+    std::atomic<uint32_t>                m_parked_workers  = 0;
+
+    /// The worker running on the current thread, if any
+    static inline thread_local Worker*   s_current_worker  = nullptr;
 
     explicit
     ThreadPool(uint32_t const thread_count)
@@ -106,44 +189,117 @@ struct ThreadPool final
     {
         m_workers.reserve(thread_count);
         for (uint32_t i{thread_count}; i--;) {
-            m_workers.emplace_back(m_queue, static_cast<uint32_t>(m_workers.size()));
+            m_workers.push_back(std::make_unique<Worker>(*this, static_cast<uint32_t>(m_workers.size())));
+        }
+        // Threads start once all the workers exist since they steal from each other
+        for (auto& worker : m_workers) {
+            worker->m_thread = std::thread([this, &worker = *worker]() {
+                run(worker);
+            });
         }
     }
 
     virtual ~ThreadPool()
     {
-        for (Worker& worker : m_workers) {
-            worker.stop();
+        for (auto& worker : m_workers) {
+            worker->requestStop();
+        }
+        {
+            std::lock_guard<std::mutex> lock_guard{m_park_mutex};
+        }
+        m_park_condition.notify_all();
+        for (auto& worker : m_workers) {
+            worker->join();
         }
     }
 
+    /// Adds a task, from a worker it goes to its own deque and from any other thread to the shared queue
     template<typename TCallback>
     void addTask(TCallback&& callback)
     {
-        m_queue.addTask(std::forward<TCallback>(callback));
+        addPendingTask(nullptr, std::forward<TCallback>(callback));
     }
 
-    void waitForCompletion() const
+    /// Adds a task to @p group, see addTask
+    template<typename TCallback>
+    void addTask(TaskGroup& group, TCallback&& callback)
     {
-        m_queue.waitForCompletion();
+        group.m_remaining_tasks.fetch_add(1, std::memory_order_relaxed);
+        addPendingTask(&group, std::forward<TCallback>(callback));
     }
 
-    template<typename TCallback>
-    void dispatch(size_t element_count, TCallback&& callback)
+    /** Waits for the tasks of @p group to be done, other tasks can still be pending or running.
+     *  Pending tasks of the group are run meanwhile, from the deque of the calling worker or from the shared queue.
+     *  Tasks of other groups are left to the workers, so a long unrelated task never delays the wait.
+     */
+    void wait(TaskGroup const& group)
     {
-        const size_t batch_size = element_count / m_thread_count;
-        for (size_t i{0}; i < m_thread_count; ++i) {
-            const size_t start = batch_size * i;
-            const size_t end   = start + batch_size;
-            addTask([start, end, &callback](){ callback(start, end); });
+        Worker* const worker = getCurrentWorker();
+        while (!group.isDone()) {
+            PendingTask pending;
+            if (getGroupTask(worker, group, pending)) {
+                execute(pending);
+            } else {
+                wait();
+            }
         }
+    }
 
-        if (batch_size * m_thread_count < element_count) {
-            const uint32_t start = batch_size * m_thread_count;
-            callback(start, element_count);
+    /// Waits for all the tasks of the pool to be done, running pending ones meanwhile, prefer wait(group) to only wait for some
+    void waitForCompletion()
+    {
+        Worker* const worker = getCurrentWorker();
+        while (m_remaining_tasks > 0) {
+            runPendingTask(worker);
+        }
+    }
+
+    /// Returns the smallest multiple of @p grain keeping chunks of @p TElement on whole cache lines, to avoid false sharing
+    template<typename TElement>
+    static constexpr size_t getAlignedGrain(size_t grain)
+    {
+        constexpr size_t cache_line_size = 64;
+        constexpr size_t line_elements = (sizeof(TElement) < cache_line_size) ? std::lcm(sizeof(TElement), cache_line_size) / sizeof(TElement) : 1;
+        return ((std::max<size_t>(grain, 1) + line_elements - 1) / line_elements) * line_elements;
+    }
+
+    /** Calls @p callback(start, end) on chunks covering [0, count) in parallel, the calling thread processes chunks too.
+     *  Chunks are claimed dynamically with guided sizes, large at first then shrinking down to @p grain, so that uneven costs balance out.
+     *  Chunk boundaries are multiples of @p grain, getAlignedGrain makes them match cache lines.
+     *  Returns once all the chunks are processed, without waiting for unrelated tasks.
+     */
+    template<typename TCallback>
+    void parallelFor(size_t count, size_t grain, TCallback&& callback)
+    {
+        grain = std::max<size_t>(grain, 1);
+        size_t const chunk_count = (count + grain - 1) / grain;
+        if (chunk_count == 0) {
+            return;
         }
+        // No helper without a chunk for it
+        uint32_t const helper_count = static_cast<uint32_t>(std::min<size_t>(m_thread_count, chunk_count - 1));
+        ParallelForJob job{count, grain, helper_count + 1};
+        auto const process = [&job, &callback] {
+            size_t start;
+            size_t end;
+            while (job.claim(start, end)) {
+                callback(start, end);
+            }
+        };
+        TaskGroup helpers;
+        for (uint32_t i{0}; i < helper_count; ++i) {
+            addTask(helpers, process);
+        }
+        process();
+        // Helpers reference the job, wait for them even if no chunk is left
+        wait(helpers);
+    }
 
-        waitForCompletion();
+    /// Calls @p callback(start, end) on ranges covering [0, element_count) in parallel, see parallelFor
+    template<typename TCallback>
+    void dispatch(size_t element_count, TCallback&& callback)
+    {
+        parallelFor(element_count, 1, callback);
     }
 
     template<typename TContainer, typename TCallback>
@@ -155,6 +311,211 @@ struct ThreadPool final
             }
         });
     }
+
+private:
+    /// Returns the worker of this pool running on the current thread, nullptr for other threads
+    Worker* getCurrentWorker() const
+    {
+        Worker* const worker = s_current_worker;
+        return (worker && worker->m_pool == this) ? worker : nullptr;
+    }
+
+    static void wait()
+    {
+        std::this_thread::yield();
+    }
+
+    template<typename TCallback>
+    void addPendingTask(TaskGroup* group, TCallback&& callback)
+    {
+        ++m_remaining_tasks;
+        if (Worker* const worker = getCurrentWorker()) {
+            TaskNode* const node = worker->allocateNode();
+            node->pending.task = Task{std::forward<TCallback>(callback)};
+            node->pending.group = group;
+            worker->m_deque.push(node);
+        } else {
+            PendingTask pending{Task{std::forward<TCallback>(callback)}, group};
+            while (!m_queue.tryPush(std::move(pending))) {
+                runPendingTask(nullptr);
+            }
+        }
+        notifyWorker();
+    }
+
+    void run(Worker& worker)
+    {
+        s_current_worker = &worker;
+        PendingTask pending;
+        while (worker.m_running) {
+            if (findTask(worker, pending)) {
+                execute(pending);
+            } else {
+                park(worker);
+            }
+        }
+    }
+
+    void execute(PendingTask& pending)
+    {
+        pending.task();
+        // Captures are destroyed before the task counts as done, the group can be destroyed as soon as it is
+        pending.task.reset();
+        if (pending.group) {
+            pending.group->m_remaining_tasks.fetch_sub(1, std::memory_order_release);
+        }
+        --m_remaining_tasks;
+    }
+
+    /// Runs a pending task if any, otherwise yields, @p worker is the worker of the calling thread if any
+    void runPendingTask(Worker* worker)
+    {
+        PendingTask pending;
+        if (getTask(worker, pending)) {
+            execute(pending);
+        } else {
+            wait();
+        }
+    }
+
+    /// Moves the task of @p node to @p pending and recycles the node
+    static void takeTask(TaskNode* node, PendingTask& pending, Worker const* current_worker)
+    {
+        pending = std::move(node->pending);
+        node->owner->releaseNode(node, current_worker);
+    }
+
+    /// Gets a task for @p worker, nullptr for other threads, returns false if none is available
+    bool getTask(Worker* worker, PendingTask& pending)
+    {
+        TaskNode* node;
+        if (worker && worker->m_deque.pop(node)) {
+            takeTask(node, pending, worker);
+            return true;
+        }
+        // Steal from random workers, one attempt each
+        uint32_t const worker_count = static_cast<uint32_t>(m_workers.size());
+        uint32_t const first = worker ? worker->getRandom() : 0;
+        for (uint32_t i{0}; i < worker_count; ++i) {
+            Worker& victim = *m_workers[(first + i) % worker_count];
+            if (&victim != worker && victim.m_deque.steal(node)) {
+                takeTask(node, pending, worker);
+                return true;
+            }
+        }
+        return m_queue.tryPop(pending);
+    }
+
+    /** Gets a task of @p group reachable by @p worker, nullptr for other threads, returns false if none is available.
+     *  Other workers' deques are left alone, their owners and the thieves run the tasks of the group found there.
+     */
+    bool getGroupTask(Worker* worker, TaskGroup const& group, PendingTask& pending)
+    {
+        if (worker && popGroupTask(*worker, group, pending)) {
+            return true;
+        }
+        if (!m_queue.tryPop(pending)) {
+            return false;
+        }
+        if (pending.group == &group) {
+            return true;
+        }
+        // Tasks of other groups go back at the end of the queue, like addTask it runs them when the queue is full
+        if (m_queue.tryPush(std::move(pending))) {
+            // A worker may have parked while the task was out of the queue
+            notifyWorker();
+        } else {
+            execute(pending);
+        }
+        return false;
+    }
+
+    /** Pops the most recent task of @p group from the deque of @p worker, the tasks above it are pushed back in order.
+     *  When too many tasks of other groups are above, the most recent one is taken instead so that the deque still drains.
+     */
+    bool popGroupTask(Worker& worker, TaskGroup const& group, PendingTask& pending)
+    {
+        constexpr uint32_t max_skipped_count = 32;
+        TaskNode* skipped[max_skipped_count];
+        uint32_t skipped_count{0};
+        TaskNode* node{nullptr};
+        bool found{false};
+        while (!found && skipped_count < max_skipped_count && worker.m_deque.pop(node)) {
+            found = (node->pending.group == &group);
+            if (!found) {
+                skipped[skipped_count++] = node;
+            }
+        }
+        uint32_t kept_count{0};
+        if (!found && skipped_count == max_skipped_count) {
+            node = skipped[0];
+            found = true;
+            kept_count = 1;
+        }
+        if (skipped_count > kept_count) {
+            while (skipped_count > kept_count) {
+                worker.m_deque.push(skipped[--skipped_count]);
+            }
+            notifyWorker();
+        }
+        if (found) {
+            takeTask(node, pending, &worker);
+        }
+        return found;
+    }
+
+    /// Looks for a task while spinning, returns false if none was found
+    bool findTask(Worker& worker, PendingTask& pending)
+    {
+        for (uint32_t i{0}; i < worker.m_spin_count; ++i) {
+            if (getTask(&worker, pending)) {
+                worker.m_spin_count = std::min(Worker::max_spin_count, worker.m_spin_count * 2);
+                return true;
+            }
+            wait();
+        }
+        worker.m_spin_count = std::max(Worker::min_spin_count, worker.m_spin_count / 2);
+        return false;
+    }
+
+    [[nodiscard]]
+    bool hasPendingTasks() const
+    {
+        if (!m_queue.empty()) {
+            return true;
+        }
+        for (auto const& worker : m_workers) {
+            if (!worker->m_deque.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Blocks @p worker until a task is added or the pool stops
+    void park(Worker& worker)
+    {
+        std::unique_lock<std::mutex> lock{m_park_mutex};
+        ++m_parked_workers;
+        // Pairs with the fence of notifyWorker: either the task is seen here or the parked worker is seen there
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_park_condition.wait(lock, [&] { return hasPendingTasks() || !worker.m_running; });
+        --m_parked_workers;
+    }
+
+    /// Wakes a parked worker if any, spinning workers find new tasks by themselves
+    void notifyWorker()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_parked_workers.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        // The worker releases the lock only once waiting, the notification cannot be lost
+        {
+            std::lock_guard<std::mutex> lock_guard{m_park_mutex};
+        }
+        m_park_condition.notify_one();
+    }
 };
 
 }
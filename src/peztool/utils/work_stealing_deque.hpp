@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+namespace pez
+{
+
+/** Chase–Lev work stealing deque.
+ *  The owner thread pushes and pops at the bottom without locking, any other thread can steal from the top.
+ *  The storage grows when full, previous buffers are kept until destruction since thieves may still read them.
+ *  Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+ */
+template<typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque items have to be trivially copyable");
+
+public:
+    explicit
+    WorkStealingDeque(int64_t capacity = 256)
+    {
+        m_buffers.push_back(std::make_unique<Buffer>(capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(WorkStealingDeque const&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+
+    /// Adds @p item at the bottom, owner thread only
+    void push(T item)
+    {
+        int64_t const bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t const top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity - 1) {
+            buffer = grow(buffer, bottom, top);
+        }
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /// Removes the bottom item, returns false if the deque is empty, owner thread only
+    bool pop(T& item)
+    {
+        int64_t const bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* const buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            // Empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = buffer->get(bottom);
+        if (top < bottom) {
+            return true;
+        }
+        // Last item, race against thieves
+        bool const won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    /// Removes the top item, returns false if the deque is empty or if another thread took it, any thread
+    bool steal(T& item)
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t const bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        Buffer* const buffer = m_buffer.load(std::memory_order_acquire);
+        item = buffer->get(top);
+        return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// Returns true if the deque looked empty, the result can be outdated as soon as it is returned
+    [[nodiscard]]
+    bool empty() const
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// Circular array, indices keep growing and wrap around the capacity
+    struct Buffer
+    {
+        int64_t                         capacity;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit
+        Buffer(int64_t capacity_)
+            : capacity{capacity_}
+            , items{std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity_))}
+        {}
+
+        [[nodiscard]]
+        T get(int64_t index) const
+        {
+            return items[static_cast<size_t>(index % capacity)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T item)
+        {
+            items[static_cast<size_t>(index % capacity)].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    std::atomic<int64_t> m_top{0};
+    std::atomic<int64_t> m_bottom{0};
+    std::atomic<Buffer*> m_buffer{nullptr};
+    /// All the buffers ever used, only modified by the owner
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+    Buffer* grow(Buffer* buffer, int64_t bottom, int64_t top)
+    {
+        m_buffers.push_back(std::make_unique<Buffer>(2 * buffer->capacity));
+        Buffer* const new_buffer = m_buffers.back().get();
+        for (int64_t i{top}; i < bottom; ++i) {
+            new_buffer->put(i, buffer->get(i));
+        }
+        m_buffer.store(new_buffer, std::memory_order_release);
+        return new_buffer;
+    }
+};
+
+}
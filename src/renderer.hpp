@@ -5,15 +5,23 @@
 /// Very basic renderer that draws a circle at the position 'circle_position'
 struct Renderer final : public pez::Renderer<>
 {
-    Interpolated<Vec2f> circle_position{};
+    /// Time is sampled once per tick by the app, no need to query the clock on each read
+    Interpolated<Vec2f, FrameClock> circle_position{};
 
     void render(pez::RenderContext& context) override
     {
-        float constexpr radius{200.0f};
-        sf::CircleShape shape{radius};
-        shape.setPosition(circle_position);
-        context.draw(shape);
+        // Only update the shape if the position moved since the last render
+        if (circle_position.hasChangedSince(m_last_update)) {
+            m_shape.setPosition(circle_position);
+            m_last_update = FrameClock::getTime();
+        }
+        context.draw(m_shape);
     }
+
+private:
+    sf::CircleShape m_shape{200.0f};
+    /// The frame time of the last shape update
+    Tick m_last_update{0};
 };
 
 